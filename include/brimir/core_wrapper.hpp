@@ -6,6 +6,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
@@ -30,6 +31,10 @@ namespace smpc {
 struct PersistentSMPCData;
 }
 
+namespace savestate {
+struct SaveState;
+}
+
 namespace peripheral {
 class ControlPad;
 struct PeripheralReport;
@@ -37,14 +42,33 @@ enum class Button : uint16_t;
 }
 }
 
+namespace util {
+class ScopedThreadPlacement;
+}
+
 namespace brimir {
 
+class RewindBuffer;
+class StateContainer;
+
 enum class ConsoleRegion {
     NTSC,
     PAL,
     Unknown,
 };
 
+enum class FrameskipMode {
+    Off,   ///< Render every frame
+    Fixed, ///< Skip a fixed number of frames after every rendered frame
+    Auto,  ///< Skip frames while the host falls behind
+};
+
+enum class ThreadPriority {
+    Normal,   ///< Leave thread priorities alone
+    High,     ///< Raise the nice value of the emulation, render and audio threads
+    Realtime, ///< Like High, plus SCHED_FIFO for the emulation and audio threads
+};
+
 /// @brief Wraps the Ymir Saturn emulator for use with libretro
 class CoreWrapper {
 public:
@@ -120,7 +144,10 @@ public:
     void RefreshSRAMFromEmulator();
 
     /// @brief Run one frame of emulation
-    void RunFrame();
+    /// @param shadow If true, run a shadow frame: emulated state advances exactly as
+    ///        usual, but VDP2 composition, video output and audio output are skipped.
+    ///        The previously presented frame remains available via GetFramebuffer().
+    void RunFrame(bool shadow = false);
 
     /// @brief Reset the emulator
     void Reset();
@@ -147,6 +174,24 @@ public:
     /// @param buttons Button states (libretro button mask)
     void SetControllerState(unsigned int port, uint16_t buttons);
 
+    /// @brief Callback that returns the current libretro button mask for a port
+    using InputStateCallback = uint16_t (*)(unsigned int port);
+
+    /// @brief Set the callback used to fetch input in late polling mode
+    /// @param callback Function returning the libretro button mask for a port, or nullptr
+    void SetInputStateCallback(InputStateCallback callback) { m_inputStateCallback = callback; }
+
+    /// @brief Enable or disable late input polling
+    /// When enabled and an input state callback is set, the SMPC peripheral report
+    /// callbacks fetch fresh input at the moment the game reads the pads instead of
+    /// using the masks last passed to SetControllerState(). The callback is invoked
+    /// on the thread running RunFrame().
+    /// @param enable True to poll input when the game samples the pads
+    void SetLateInputPolling(bool enable) { m_lateInputPolling = enable; }
+
+    /// @brief Check if late input polling is enabled
+    bool IsLateInputPolling() const { return m_lateInputPolling; }
+
     /// @brief Get the current video frame buffer
     /// @return Pointer to framebuffer data, or nullptr if not available
     const void* GetFramebuffer() const;
@@ -228,6 +273,28 @@ public:
     /// @brief Set threaded VDP2 rendering
     void SetThreadedVDP2(bool enable);
 
+    /// @brief Set the number of threads the emulator may run at once
+    /// The budget is shared by every core instance in the process. It covers the thread calling RunFrame(), the VDP,
+    /// SCSP and SH-2 worker threads, and the helpers that compress save states and rewind snapshots, which only get
+    /// whatever the other threads leave over.
+    /// @param threads Thread budget (0 picks one from the host's hardware thread count)
+    static void SetThreadBudget(size_t threads);
+
+    /// @brief Configure where the emulator threads run and at which priority (Linux only)
+    /// Applies to every core instance in the process, including threads that are already running. Automatic placement
+    /// gives the emulation thread the fastest physical core to itself and spreads the render and audio threads over
+    /// the other cores, one per core as far as they go.
+    /// @param automatic Place threads on distinct physical cores
+    /// @param priority Priority preset for the emulation, render and audio threads
+    /// @param overrides Per-thread settings applied on top of the above, in the util::ParseThreadPlacements format,
+    ///                  e.g. "vdp2:cpus=2-3:nice=-5;scsp:fifo=20". Null or empty for none.
+    /// @return false if the overrides are malformed, in which case they are ignored
+    static bool SetThreadPlacement(bool automatic, ThreadPriority priority, const char* overrides);
+
+    /// @brief Check whether the OS accepted the whole thread placement
+    /// Raising priorities usually requires CAP_SYS_NICE or suitable RLIMIT_NICE and RLIMIT_RTPRIO limits.
+    static bool IsThreadPlacementApplied();
+
     /// @brief Set deinterlacing enable
     void SetDeinterlacing(bool enable);
 
@@ -248,6 +315,67 @@ public:
     /// @param vertical Total vertical pixels to crop (from both edges)
     void SetOverscanCrop(int horizontal, int vertical);
 
+    /// @brief Set the number of frames to run ahead internally
+    /// Each call to RunFrame() advances the real timeline by one frame, then runs this many
+    /// speculative frames with the current input and presents the last one. The speculative
+    /// frames are undone by restoring an uncompressed in-memory snapshot.
+    /// @param frames Frames to run ahead (0 disables, clamped to kMaxRunAheadFrames)
+    void SetRunAheadFrames(unsigned int frames);
+
+    /// @brief Get the number of frames to run ahead internally
+    unsigned int GetRunAheadFrames() const { return m_runAheadFrames; }
+
+    /// @brief Maximum number of internal runahead frames
+    static constexpr unsigned int kMaxRunAheadFrames = 4;
+
+    /// @brief Set the size of the core-managed rewind buffer
+    /// While enabled, a snapshot is recorded after every frame and stored as an LZ4-compressed XOR delta against the
+    /// previous one, with periodic keyframes. Changing the size drops the recorded history.
+    /// @param megabytes Buffer size in MiB (0 disables rewinding and frees the buffer)
+    void SetRewindBufferSize(size_t megabytes);
+
+    /// @brief Set whether the emulator is rewinding
+    /// While rewinding, each RunFrame() steps back one recorded frame and presents it without audio instead of
+    /// advancing. Has no effect while the rewind buffer is disabled.
+    /// @param rewinding True to step backwards
+    void SetRewinding(bool rewinding) { m_rewinding = rewinding; }
+
+    /// @brief Get the number of frames recorded in the rewind buffer
+    size_t GetRewindFrameCount() const;
+
+    /// @brief Configure frame skipping
+    /// Skipped frames advance the emulated state exactly like rendered frames, VDP1 drawing included, and produce
+    /// audio as usual, but bypass VDP2 line rendering and composition. The previous frame stays in the framebuffer.
+    /// Auto mode skips a frame when the frontend reports that its audio buffer is about to underrun or, while it
+    /// reports no audio buffer status, when frames arrive more than a frame period behind the target frame rate.
+    /// Neither mode skips more than kMaxFrameskip frames in a row.
+    /// @param mode Frame skipping mode
+    /// @param frames Frames to skip after every rendered frame in fixed mode (clamped to kMaxFrameskip)
+    void SetFrameskip(FrameskipMode mode, unsigned int frames = 0);
+
+    /// @brief Get the frame skipping mode
+    FrameskipMode GetFrameskipMode() const { return m_frameskipMode; }
+
+    /// @brief Maximum number of consecutive skipped frames
+    static constexpr unsigned int kMaxFrameskip = 3;
+
+    /// @brief Set the frame rate auto frameskip tries to keep up with
+    /// @param fps Frames per second; non-positive values are ignored
+    void SetTargetFrameRate(double fps);
+
+    /// @brief Report the frontend audio buffer status to auto frameskip
+    /// @param active Whether the frontend reports the status; frame timing is used while inactive
+    /// @param underrunLikely Whether the frontend expects the buffer to underrun during the next frame
+    void SetAudioBufferStatus(bool active, bool underrunLikely);
+
+    /// @brief Skip video output of the next frame regardless of the frameskip mode
+    /// For frames whose image the frontend is going to discard anyway.
+    void RequestFrameSkip() { m_frameSkipRequested = true; }
+
+    /// @brief Check if the last RunFrame() skipped video output
+    /// Skipped frames are counted under "Frameskip_Skipped" in the profiling report.
+    bool IsFrameSkipped() const { return m_frameSkipped; }
+
     // --- Disk control (multi-disc games via M3U) ---
 
     /// @brief Get the number of discs in the loaded M3U playlist
@@ -284,6 +412,9 @@ public:
     /// @return Performance profiling data as string
     std::string GetProfilingReport() const { return m_profiler.GetReport(); }
     
+    /// @brief Get the profiler holding the section timings
+    const Profiler& GetProfiler() const { return m_profiler; }
+    
     /// @brief Reset profiling data
     void ResetProfiling() { m_profiler.Reset(); }
 
@@ -294,6 +425,13 @@ private:
     /// @brief Callback for when SCSP outputs an audio sample
     void OnAudioSample(int16_t left, int16_t right);
 
+    /// @brief Run one real frame followed by m_runAheadFrames speculative frames
+    /// @param skipVideo Whether to skip video output of the presented speculative frame
+    void RunFrameWithRunAhead(bool skipVideo);
+
+    /// @brief Decide whether to skip video output of the frame about to run
+    bool ShouldSkipFrame();
+
     std::unique_ptr<ymir::Saturn> m_saturn;
     bool m_initialized = false;
     bool m_gameLoaded = false;
@@ -323,6 +461,40 @@ private:
     static constexpr size_t kAudioRingBufferStereoCapacity = 2048;
     AudioRingBuffer<kAudioRingBufferStereoCapacity> m_audioRingBuffer;
     
+    // Internal runahead. The snapshot is allocated once when runahead is enabled and
+    // reused every frame, so no compression or heap allocation happens per frame.
+    unsigned int m_runAheadFrames = 0;
+    std::unique_ptr<ymir::savestate::SaveState> m_runAheadState;
+
+    // Frame skipping. Auto mode accumulates how far frame starts fall behind the target frame period.
+    FrameskipMode m_frameskipMode = FrameskipMode::Off;
+    unsigned int m_frameskipFrames = 0;
+    unsigned int m_framesSkippedInRow = 0;
+    bool m_frameSkipped = false;
+    bool m_frameSkipRequested = false;
+    std::chrono::duration<double> m_targetFramePeriod{1.0 / 59.94};
+    std::chrono::duration<double> m_frameLag{0};
+    std::chrono::steady_clock::time_point m_lastFrameStart{};
+    bool m_audioBufferStatusActive = false;
+    bool m_audioUnderrunLikely = false;
+
+    // Save states are encoded in sections compressed in parallel. The scratch state and the container buffers are
+    // allocated on first use and reused afterwards.
+    std::unique_ptr<StateContainer> m_stateContainer;
+    std::unique_ptr<ymir::savestate::SaveState> m_stateScratch;
+
+    // Registers the thread calling RunFrame() for thread placement on the first frame
+    std::unique_ptr<util::ScopedThreadPlacement> m_emulationThreadPlacement;
+    void EnsureStateContainer();
+
+    // Core-managed rewind. Snapshots are uncompressed state container payloads, which keep the same layout from one
+    // frame to the next, so consecutive snapshots diff well.
+    std::unique_ptr<RewindBuffer> m_rewindBuffer;
+    std::vector<uint8_t> m_rewindImage;
+    bool m_rewinding = false;
+    void CaptureRewindFrame();
+    void StepRewindFrame();
+
     // Input devices (raw pointers owned by Saturn's SMPC)
     ymir::peripheral::ControlPad* m_controller1 = nullptr;
     ymir::peripheral::ControlPad* m_controller2 = nullptr;
@@ -330,6 +502,10 @@ private:
     // Button states for each port (stored for peripheral callback)
     uint16_t m_port1Buttons = 0;
     uint16_t m_port2Buttons = 0;
+
+    // Late input polling: query the frontend from the peripheral report callbacks
+    bool m_lateInputPolling = false;
+    InputStateCallback m_inputStateCallback = nullptr;
     
     // Peripheral report callbacks
     void OnPeripheralReport1(ymir::peripheral::PeripheralReport& report);
@@ -53,10 +53,22 @@ public:
         return m_timings;
     }
     
-    /// @brief Reset all timing data
+    /// @brief Add to a named event counter
+    void Count(const std::string& name, size_t amount = 1) {
+        m_counts[name] += amount;
+    }
+    
+    /// @brief Get the value of an event counter, or 0 if it was never counted
+    size_t GetCount(const std::string& name) const {
+        auto it = m_counts.find(name);
+        return it != m_counts.end() ? it->second : 0;
+    }
+    
+    /// @brief Reset all timing data and counters
     void Reset() {
         m_timings.clear();
         m_startTimes.clear();
+        m_counts.clear();
     }
     
     /// @brief Get profiler report as string
@@ -68,12 +80,16 @@ public:
                      "max=" + std::to_string(timing.maxMs) + "ms, " +
                      "samples=" + std::to_string(timing.count) + "\n";
         }
+        for (const auto& [name, count] : m_counts) {
+            report += name + ": count=" + std::to_string(count) + "\n";
+        }
         return report;
     }
     
 private:
     std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> m_startTimes;
     std::unordered_map<std::string, Timing> m_timings;
+    std::unordered_map<std::string, size_t> m_counts;
 };
 
 /// @brief RAII helper for automatic timing
@@ -0,0 +1,110 @@
+// Brimir - Core-managed rewind history
+// Copyright (C) 2025 coredds
+// Licensed under GPL-3.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace util {
+class ThreadPool;
+}
+
+namespace brimir {
+
+/// @brief Fixed-size ring of snapshots used to step the emulator back one frame at a time.
+///
+/// Snapshots are flat byte images such as uncompressed StateContainer payloads. Each snapshot is stored as the XOR
+/// against the previous one, which is almost entirely zero between consecutive frames, split into blocks that are
+/// LZ4-compressed in parallel. All-zero blocks take no space at all. Every few frames a keyframe stores the full
+/// snapshot instead. Images of different sizes are diffed as if the shorter one was zero-extended.
+///
+/// The newest snapshot is kept uncompressed, so stepping back across a delta only undoes that delta. Stepping back
+/// across a keyframe rebuilds the previous snapshot from the keyframe before it. When the ring runs out of space, the
+/// oldest keyframe is dropped along with the deltas that depend on it.
+class RewindBuffer {
+public:
+    /// @brief Default number of snapshots between keyframes
+    static constexpr size_t kDefaultKeyframeInterval = 120;
+
+    /// @brief Creates an empty rewind buffer
+    /// @param pool Threads used to encode and decode blocks
+    /// @param capacity Size of the ring in bytes
+    /// @param keyframeInterval Number of snapshots between keyframes
+    RewindBuffer(util::ThreadPool& pool, size_t capacity, size_t keyframeInterval = kDefaultKeyframeInterval);
+
+    /// @brief Records a new snapshot.
+    ///
+    /// The snapshot becomes the new head by swapping buffers, so `image` holds unspecified contents afterwards.
+    /// Nothing changes if the encoded snapshot is larger than the whole ring.
+    ///
+    /// @param image Snapshot to record
+    /// @return true if the snapshot was recorded
+    bool Push(std::vector<uint8_t>& image);
+
+    /// @brief Drops the newest snapshot, making the one before it the head
+    /// @return true if there was an older snapshot to go back to
+    bool Pop();
+
+    /// @brief Get the newest snapshot, or an empty span if there are none
+    std::span<const uint8_t> GetHead() const { return m_head; }
+
+    /// @brief Drops all snapshots
+    void Clear();
+
+    /// @brief Get the number of snapshots held
+    size_t GetFrameCount() const { return m_records.size(); }
+
+    /// @brief Get the size of the ring in bytes
+    size_t GetCapacity() const { return m_capacity; }
+
+    /// @brief Get the number of ring bytes taken up by snapshots
+    size_t GetUsedBytes() const { return m_usedBytes; }
+
+private:
+    struct Record {
+        size_t offset;    // Position in the ring
+        size_t size;      // Encoded size
+        size_t rawSize;   // Decoded size; the larger of the two image sizes for deltas
+        size_t imageSize; // Size of the snapshot
+        bool keyframe;
+    };
+
+    /// @brief Encodes `src` XOR `base`, both zero-extended to the larger size, into the block buffers
+    /// @param base Previous snapshot, or null to encode a keyframe
+    /// @return Encoded size
+    size_t Encode(const uint8_t* src, size_t srcSize, const uint8_t* base, size_t baseSize);
+
+    /// @brief Decodes a record into `dst`, which must hold at least record.rawSize bytes
+    /// @param xorInto Whether to XOR the decoded bytes into `dst` instead of overwriting them
+    bool Decode(const Record& record, uint8_t* dst, bool xorInto);
+
+    /// @brief Makes room for `size` bytes after the newest record, dropping the oldest records as needed
+    /// @return Offset of the reserved space
+    size_t Reserve(size_t size);
+
+    void DropOldest();
+
+    util::ThreadPool& m_pool;
+    const size_t m_keyframeInterval;
+
+    const size_t m_capacity;
+    std::unique_ptr<uint8_t[]> m_ring;
+    std::deque<Record> m_records;
+    size_t m_usedBytes = 0;
+    size_t m_framesSinceKeyframe = 0;
+
+    std::vector<uint8_t> m_head;
+
+    // Encoding scratch, reused across snapshots
+    std::vector<std::vector<uint8_t>> m_blockBuffers;
+    std::vector<uint32_t> m_blockSizes;
+    std::vector<std::vector<uint8_t>> m_decodeBuffers;
+};
+
+} // namespace brimir
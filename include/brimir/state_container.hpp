@@ -0,0 +1,88 @@
+// Brimir - Sectioned save state container
+// Copyright (C) 2025 coredds
+// Licensed under GPL-3.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ymir::savestate {
+struct SaveState;
+}
+
+namespace util {
+class ThreadPool;
+}
+
+namespace brimir {
+
+/// @brief Sections of a save state, each compressed independently
+enum class StateSection : uint32_t {
+    Devices,               ///< Everything not covered by another section: scheduler, registers, device state
+    CPUs,                  ///< Master and slave SH-2
+    WRAMLow,               ///< Low work RAM
+    WRAMHigh,              ///< High work RAM
+    VDP1VRAM,              ///< VDP1 VRAM
+    VDP1Framebuffers,      ///< VDP1 sprite framebuffers
+    VDP1MeshFramebuffers,  ///< Renderer copies of the VDP1 framebuffers used for mesh transparency
+    VDP2Memory,            ///< VDP2 VRAM and CRAM
+    SCSPWRAM,              ///< SCSP sound RAM
+    CDBlockHLE,            ///< High-level CD block; omitted when the low-level CD block is in use
+    CDBlockLLE,            ///< SH-1, YGR and CD drive; omitted when the high-level CD block is in use
+    CDBlockDRAM,           ///< CD block DRAM; omitted when the high-level CD block is in use
+    CartData,              ///< Cartridge RAM or ROM contents; omitted when empty
+    INTBACKReport,         ///< Pending SMPC peripheral report; omitted when empty
+
+    Count
+};
+
+/// @brief Encodes save states as a table of independently compressed sections.
+///
+/// Layout: [sectionCount:4] followed by one [id:4][flags:4][rawSize:4][storedSize:4] entry per section and then the
+/// stored bytes of every section in table order. Sections are LZ4-compressed in parallel and stored as-is when they
+/// don't compress. Sections that hold no valid data for the current configuration are left out.
+class StateContainer {
+public:
+    explicit StateContainer(util::ThreadPool& pool);
+
+    /// @brief Get an upper bound for the encoded size of a state
+    /// @param cdblockLLE Whether the low-level CD block is in use
+    /// @param cartDataSize Size of the cartridge RAM or ROM contents
+    static size_t GetMaxSize(bool cdblockLLE, size_t cartDataSize);
+
+    /// @brief Encode a state
+    ///
+    /// Uncompressed output always includes the vector sections, even when empty, so that consecutive states of the same
+    /// configuration share the same layout up to the variable-sized tail. The rewind buffer relies on this to diff them.
+    ///
+    /// @param state State to encode
+    /// @param out Output buffer
+    /// @param capacity Size of the output buffer
+    /// @param compress Whether to LZ4-compress the sections
+    /// @return Number of bytes written, or 0 if the buffer is too small
+    size_t Write(const ymir::savestate::SaveState& state, uint8_t* out, size_t capacity, bool compress = true);
+
+    /// @brief Decode a state
+    ///
+    /// Sections missing from the encoded state are left untouched in the destination.
+    ///
+    /// @param in Encoded state
+    /// @param size Size of the encoded state
+    /// @param state Destination state
+    /// @return true if the encoded state is well-formed and was decoded completely
+    bool Read(const uint8_t* in, size_t size, ymir::savestate::SaveState& state);
+
+private:
+    static constexpr size_t kNumSections = static_cast<size_t>(StateSection::Count);
+
+    util::ThreadPool& m_pool;
+
+    // Per-section scratch buffers, reused across calls
+    std::array<std::vector<uint8_t>, kNumSections> m_rawBuffers;
+    std::array<std::vector<uint8_t>, kNumSections> m_packedBuffers;
+};
+
+} // namespace brimir
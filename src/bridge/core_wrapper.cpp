@@ -3,6 +3,8 @@
 // Licensed under GPL-3.0
 
 #include "brimir/core_wrapper.hpp"
+#include "brimir/rewind_buffer.hpp"
+#include "brimir/state_container.hpp"
 
 #include <ymir/ymir.hpp>
 #include <ymir/media/loader/loader.hpp>
@@ -14,13 +16,17 @@
 #include <ymir/db/rom_cart_db.hpp>
 #include <ymir/db/ipl_db.hpp>
 #include <ymir/hw/cart/cart_impl_dram.hpp>
+#include <ymir/hw/cart/cart_impl_rom.hpp>
 #include <ymir/core/hash.hpp>
 #include <ymir/hw/smpc/smpc_defs.hpp>
 #include <ymir/util/bit_ops.hpp>
+#include <ymir/util/thread_placement.hpp>
+#include <ymir/util/thread_pool.hpp>
 
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 
 #include <lz4.h>
 #include <algorithm>
@@ -53,7 +59,20 @@ constexpr uint8_t kPersistentSMPCDataVersion = 0x01;
 
 constexpr uint32_t kNewStateMagic    = 0x32524942; // "BRI2" in LE
 constexpr uint32_t kLegacyStateMagic = 0x4D495242; // "BRIM" in LE
-constexpr uint32_t kSaveStateVersion = 2;
+constexpr uint32_t kSaveStateVersion = 3;       // Sectioned payload, see StateContainer
+constexpr uint32_t kMonolithicStateVersion = 2; // Single LZ4 blob of the whole state structure
+
+// Monolithic states are raw copies of the state structure, vector objects
+// included. Their contents were never stored, so re-create the vectors in place
+// without releasing the stale pointers they hold.
+//
+// Like every raw copy, monolithic and legacy states only load while their
+// uncompressed size matches the current state structure. Any layout change
+// rejects all of them; see the save state compatibility notes in CHANGELOG.md.
+void ResetRawCopiedVectors(ymir::savestate::SaveState &state) {
+    std::construct_at(&state.scu.cartData);
+    std::construct_at(&state.smpc.intback.report);
+}
 
 bool LoadPersistentSMPCDataFromFile(ymir::smpc::PersistentSMPCData &data,
                                     const std::filesystem::path &path) {
@@ -693,6 +712,11 @@ void CoreWrapper::UnloadGame() {
     // Eject disc
     m_saturn->EjectDisc();
     m_gameLoaded = false;
+
+    // The rewind history belongs to the unloaded game
+    if (m_rewindBuffer) {
+        m_rewindBuffer->Clear();
+    }
     
     // Reset cartridge state
     m_hasCartridge = false;
@@ -900,11 +924,15 @@ size_t CoreWrapper::GetSystemRAMHighSize() const {
 }
 
 
-void CoreWrapper::RunFrame() {
+void CoreWrapper::RunFrame(bool shadow) {
     if (!m_initialized || !m_saturn) {
         return;
     }
 
+    if (!m_emulationThreadPlacement) {
+        m_emulationThreadPlacement = std::make_unique<util::ScopedThreadPlacement>(util::ThreadRole::Emulation);
+    }
+
     // On the first frame after a game is loaded, copy the canonical SRAM buffer
     // down into Ymir. By this point the frontend has had a chance to load the
     // .srm into the pointer returned by GetSRAMData(); copying earlier (in
@@ -919,12 +947,33 @@ void CoreWrapper::RunFrame() {
     try {
         ScopedTimer timer(m_profiler, "RunFrame_Total");
 
+        // Rewinding always presents the restored frame
+        const bool rewinding = m_rewindBuffer && m_rewinding && !shadow;
+        m_frameSkipped = !shadow && ShouldSkipFrame() && !rewinding;
+        m_framesSkippedInRow = m_frameSkipped ? m_framesSkippedInRow + 1 : 0;
+        if (m_frameSkipped) {
+            m_profiler.Count("Frameskip_Skipped");
+        }
+
         // Run one frame of emulation
         // VDP callback will update framebuffer via OnFrameComplete()
         // SCSP callback will update audio buffer via OnAudioSample()
+        // Neither callback fires on shadow frames. Skipped frames still produce audio.
         {
             ScopedTimer ymirTimer(m_profiler, "Ymir_RunFrame");
-            m_saturn->RunFrame();
+            if (rewinding) {
+                StepRewindFrame();
+            } else if (m_runAheadFrames > 0 && !shadow) {
+                RunFrameWithRunAhead(m_frameSkipped);
+            } else if (m_frameSkipped) {
+                m_saturn->RunFrame(true, false);
+            } else {
+                m_saturn->RunFrame(shadow);
+            }
+        }
+
+        if (m_rewindBuffer && !m_rewinding && !shadow) {
+            CaptureRewindFrame();
         }
 
         // Track frames for SRAM sync optimization
@@ -941,6 +990,145 @@ void CoreWrapper::RunFrame() {
     }
 }
 
+void CoreWrapper::RunFrameWithRunAhead(bool skipVideo) {
+    // Advance the real timeline. Its audio is what the frontend hears, but its
+    // image is superseded by the last speculative frame.
+    m_saturn->RunFrame(true, false);
+
+    {
+        ScopedTimer timer(m_profiler, "RunAhead_Snapshot");
+        m_saturn->SaveState(*m_runAheadState);
+    }
+
+    // Run speculative frames with the current input, presenting only the last one
+    for (unsigned int i = 1; i <= m_runAheadFrames; ++i) {
+        const bool last = i == m_runAheadFrames;
+        m_saturn->RunFrame(!last || skipVideo, true);
+    }
+
+    {
+        ScopedTimer timer(m_profiler, "RunAhead_Restore");
+        if (!m_saturn->LoadState(*m_runAheadState, true)) {
+            m_lastError = "RunAhead: failed to restore snapshot";
+        }
+    }
+}
+
+void CoreWrapper::SetRunAheadFrames(unsigned int frames) {
+    m_runAheadFrames = std::min(frames, kMaxRunAheadFrames);
+    if (m_runAheadFrames > 0 && !m_runAheadState) {
+        m_runAheadState = std::make_unique<ymir::savestate::SaveState>();
+    } else if (m_runAheadFrames == 0) {
+        m_runAheadState.reset();
+    }
+}
+
+bool CoreWrapper::ShouldSkipFrame() {
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> interval = now - m_lastFrameStart;
+    m_lastFrameStart = now;
+
+    // Track how far frame starts fall behind the target period. Gaps of several frames mean emulation was paused or
+    // stalled while loading, not that the host is too slow.
+    constexpr double kMaxFrameGap = 4.0;
+    if (interval > m_targetFramePeriod * kMaxFrameGap) {
+        m_frameLag = {};
+    } else {
+        m_frameLag = std::clamp(m_frameLag + interval - m_targetFramePeriod, std::chrono::duration<double>{},
+                                m_targetFramePeriod * kMaxFrameskip);
+    }
+
+    if (m_frameSkipRequested) {
+        m_frameSkipRequested = false;
+        return true;
+    }
+
+    switch (m_frameskipMode) {
+    case FrameskipMode::Off: return false;
+    case FrameskipMode::Fixed: return m_framesSkippedInRow < m_frameskipFrames;
+    case FrameskipMode::Auto: break;
+    }
+
+    if (m_framesSkippedInRow >= kMaxFrameskip) {
+        return false;
+    }
+    if (m_audioBufferStatusActive) {
+        return m_audioUnderrunLikely;
+    }
+    // Jitter around the target period averages out; only skip once a whole frame behind
+    return m_frameLag >= m_targetFramePeriod;
+}
+
+void CoreWrapper::SetFrameskip(FrameskipMode mode, unsigned int frames) {
+    m_frameskipFrames = std::min(frames, kMaxFrameskip);
+    m_frameskipMode = mode == FrameskipMode::Fixed && m_frameskipFrames == 0 ? FrameskipMode::Off : mode;
+    m_framesSkippedInRow = 0;
+    m_frameLag = {};
+}
+
+void CoreWrapper::SetTargetFrameRate(double fps) {
+    if (fps > 0.0) {
+        m_targetFramePeriod = std::chrono::duration<double>{1.0 / fps};
+    }
+}
+
+void CoreWrapper::SetAudioBufferStatus(bool active, bool underrunLikely) {
+    m_audioBufferStatusActive = active;
+    m_audioUnderrunLikely = active && underrunLikely;
+}
+
+void CoreWrapper::SetRewindBufferSize(size_t megabytes) {
+    if (megabytes == 0) {
+        m_rewindBuffer.reset();
+        m_rewindImage = {};
+        return;
+    }
+
+    const size_t capacity = megabytes * 1024 * 1024;
+    if (!m_rewindBuffer || m_rewindBuffer->GetCapacity() != capacity) {
+        EnsureStateContainer();
+        m_rewindBuffer.reset();
+        m_rewindBuffer = std::make_unique<RewindBuffer>(util::ThreadPool::Shared(), capacity);
+    }
+}
+
+size_t CoreWrapper::GetRewindFrameCount() const {
+    return m_rewindBuffer ? m_rewindBuffer->GetFrameCount() : 0;
+}
+
+void CoreWrapper::CaptureRewindFrame() {
+    ScopedTimer timer(m_profiler, "Rewind_Capture");
+
+    m_saturn->SaveState(*m_stateScratch);
+
+    // Push() hands back the previous snapshot, so growing the buffer to the bound only clears the slack at the end
+    m_rewindImage.resize(GetStateSize());
+    const size_t size = m_stateContainer->Write(*m_stateScratch, m_rewindImage.data(), m_rewindImage.size(), false);
+    m_rewindImage.resize(size);
+    if (size == 0 || !m_rewindBuffer->Push(m_rewindImage)) {
+        m_lastError = "Rewind: failed to record snapshot";
+    }
+}
+
+void CoreWrapper::StepRewindFrame() {
+    ScopedTimer timer(m_profiler, "Rewind_Step");
+
+    // Once the history runs out, keep replaying the oldest frame
+    m_rewindBuffer->Pop();
+    const auto head = m_rewindBuffer->GetHead();
+    if (head.empty()) {
+        return;
+    }
+    if (!m_stateContainer->Read(head.data(), head.size(), *m_stateScratch) ||
+        !m_saturn->LoadState(*m_stateScratch, true)) {
+        m_lastError = "Rewind: failed to restore snapshot";
+        return;
+    }
+
+    // Run the restored frame to have something to present
+    m_saturn->RunFrame(false, true);
+}
+
 void CoreWrapper::Reset() {
     if (!m_initialized || !m_saturn) {
         return;
@@ -1051,9 +1239,25 @@ size_t CoreWrapper::GetStateSize() const {
         return 0;
     }
 
-    // Header (16 bytes: magic, version, uncompressed size, compressed size)
-    // + max compressed size.
-    return static_cast<size_t>(LZ4_compressBound(static_cast<int>(sizeof(ymir::savestate::SaveState)))) + 16;
+    size_t cartDataSize = 0;
+    switch (m_saturn->GetCartridge().GetType()) {
+    case ymir::cart::CartType::DRAM8Mbit: cartDataSize = 1 * 1024 * 1024; break;
+    case ymir::cart::CartType::DRAM32Mbit: cartDataSize = 4 * 1024 * 1024; break;
+    case ymir::cart::CartType::DRAM48Mbit: cartDataSize = 6 * 1024 * 1024; break;
+    case ymir::cart::CartType::ROM: cartDataSize = ymir::cart::kROMCartSize; break;
+    default: break;
+    }
+
+    // Header (16 bytes: magic, version, uncompressed size, payload size)
+    // + max sectioned payload size.
+    return StateContainer::GetMaxSize(m_saturn->IsCDBlockLLE(), cartDataSize) + 16;
+}
+
+void CoreWrapper::EnsureStateContainer() {
+    if (!m_stateContainer) {
+        m_stateContainer = std::make_unique<StateContainer>(util::ThreadPool::Shared());
+        m_stateScratch = std::make_unique<ymir::savestate::SaveState>();
+    }
 }
 
 bool CoreWrapper::SaveState(void* data, size_t size) {
@@ -1071,10 +1275,10 @@ bool CoreWrapper::SaveState(void* data, size_t size) {
         // Ymir's software renderer handles its own worker-thread synchronization
         // in VDP::SaveState() via PreSaveStateSync(). The libretro frontend
         // ensures serialize/unserialize do not run concurrently with retro_run().
-        auto state = std::make_unique<ymir::savestate::SaveState>();
-        m_saturn->SaveState(*state);
+        EnsureStateContainer();
+        m_saturn->SaveState(*m_stateScratch);
 
-        // Write 16-byte header: magic + version + uncompressed size + placeholder compressed size
+        // Write 16-byte header: magic + version + uncompressed size + payload size
         const uint32_t magic = kNewStateMagic;
         const uint32_t version = kSaveStateVersion;
         const uint32_t uncompSize = static_cast<uint32_t>(sizeof(ymir::savestate::SaveState));
@@ -1083,23 +1287,15 @@ bool CoreWrapper::SaveState(void* data, size_t size) {
         std::memcpy(out + 4, &version, 4);
         std::memcpy(out + 8, &uncompSize, 4);
 
-        // Compress with LZ4
-        int srcSize = static_cast<int>(sizeof(ymir::savestate::SaveState));
-        int dstCapacity = static_cast<int>(size - 16);
-        int compressedSize = LZ4_compress_default(
-            reinterpret_cast<const char*>(state.get()),
-            reinterpret_cast<char*>(out + 16),
-            srcSize,
-            dstCapacity
-        );
-
-        if (compressedSize <= 0) {
+        const size_t payloadSize = m_stateContainer->Write(*m_stateScratch, out + 16, size - 16);
+        if (payloadSize == 0) {
             return false;
         }
 
-        // Fill in the actual compressed payload size so LoadState can ignore
-        // any trailing bytes that the frontend may have written.
-        std::memcpy(out + 12, &compressedSize, 4);
+        // Fill in the actual payload size so LoadState can ignore any
+        // trailing bytes that the frontend may have written.
+        const uint32_t payloadSize32 = static_cast<uint32_t>(payloadSize);
+        std::memcpy(out + 12, &payloadSize32, 4);
 
         return true;
     } catch (const std::exception& e) {
@@ -1125,20 +1321,37 @@ bool CoreWrapper::LoadState(const void* data, size_t size) {
         uint32_t magic = 0;
         std::memcpy(&magic, in, 4);
 
-        // New format: [magic:4][version:4][uncompSize:4][compressedSize:4] followed by LZ4 data
+        // New format: [magic:4][version:4][uncompSize:4][payloadSize:4] followed by
+        // the sectioned payload (v3) or a single LZ4 blob (v2)
         if (magic == kNewStateMagic && size >= 12) {
             uint32_t version = 0;
             uint32_t uncompSize = 0;
             std::memcpy(&version, in + 4, 4);
             std::memcpy(&uncompSize, in + 8, 4);
 
-            if (version != kSaveStateVersion) {
+            if (version != kSaveStateVersion && version != kMonolithicStateVersion) {
                 return false;
             }
             if (uncompSize != sizeof(ymir::savestate::SaveState)) {
                 return false;
             }
 
+            if (version == kSaveStateVersion) {
+                if (size < 16) {
+                    return false;
+                }
+                uint32_t payloadSize = 0;
+                std::memcpy(&payloadSize, in + 12, 4);
+                if (payloadSize > size - 16) {
+                    return false;
+                }
+                EnsureStateContainer();
+                if (!m_stateContainer->Read(in + 16, payloadSize, *m_stateScratch)) {
+                    return false;
+                }
+                return m_saturn->LoadState(*m_stateScratch, true);
+            }
+
             int headerSize;
             int compressedSize;
             if (size >= 16) {
@@ -1161,6 +1374,7 @@ bool CoreWrapper::LoadState(const void* data, size_t size) {
                 compressedSize,
                 static_cast<int>(uncompSize)
             );
+            ResetRawCopiedVectors(*state);
             if (result != static_cast<int>(uncompSize)) {
                 return false;
             }
@@ -1183,6 +1397,7 @@ bool CoreWrapper::LoadState(const void* data, size_t size) {
                 compressedSize,
                 static_cast<int>(uncompSize)
             );
+            ResetRawCopiedVectors(*state);
             if (result != static_cast<int>(uncompSize)) {
                 return false;
             }
@@ -1402,6 +1617,10 @@ void CoreWrapper::SetControllerState(unsigned int port, uint16_t buttons) {
 
 void CoreWrapper::OnPeripheralReport1(ymir::peripheral::PeripheralReport& report) {
     if (report.type == ymir::peripheral::PeripheralType::ControlPad) {
+        // In late polling mode, sample the frontend right as the game reads the pad
+        if (m_lateInputPolling && m_inputStateCallback) {
+            m_port1Buttons = m_inputStateCallback(0);
+        }
         // Convert libretro button mask to Saturn button states
         report.report.controlPad.buttons = ConvertLibretroButtons(m_port1Buttons);
     }
@@ -1409,6 +1628,9 @@ void CoreWrapper::OnPeripheralReport1(ymir::peripheral::PeripheralReport& report
 
 void CoreWrapper::OnPeripheralReport2(ymir::peripheral::PeripheralReport& report) {
     if (report.type == ymir::peripheral::PeripheralType::ControlPad) {
+        if (m_lateInputPolling && m_inputStateCallback) {
+            m_port2Buttons = m_inputStateCallback(1);
+        }
         // Convert libretro button mask to Saturn button states
         report.report.controlPad.buttons = ConvertLibretroButtons(m_port2Buttons);
     }
@@ -1581,6 +1803,47 @@ void CoreWrapper::SetThreadedVDP2(bool enable) {
     m_saturn->configuration.video.threadedVDP2 = enable;
 }
 
+void CoreWrapper::SetThreadBudget(size_t threads) {
+    util::ThreadPool::Shared().SetThreadBudget(threads);
+}
+
+bool CoreWrapper::SetThreadPlacement(bool automatic, ThreadPriority priority, const char* overrides) {
+    using util::ThreadRole;
+
+    util::ThreadPlacements placements{};
+    auto placement = [&](ThreadRole role) -> util::ThreadPlacement& { return placements[static_cast<size_t>(role)]; };
+
+    if (priority != ThreadPriority::Normal) {
+        for (const ThreadRole role : {ThreadRole::Emulation, ThreadRole::VDP1Render, ThreadRole::VDP2Render,
+                                      ThreadRole::VDPDeinterlace, ThreadRole::SCSP, ThreadRole::SH2Speculation}) {
+            placement(role).nice = -10;
+        }
+    }
+    if (priority == ThreadPriority::Realtime) {
+        // Audio goes above the emulation thread that feeds it so a late sample batch never waits behind a frame
+        placement(ThreadRole::Emulation).realtimePriority = 10;
+        placement(ThreadRole::SCSP).realtimePriority = 11;
+    }
+
+    bool valid = true;
+    if (overrides != nullptr && overrides[0] != '\0') {
+        if (const auto parsed = util::ParseThreadPlacements(overrides)) {
+            for (size_t i = 0; i < placements.size(); ++i) {
+                placements[i].Merge((*parsed)[i]);
+            }
+        } else {
+            valid = false;
+        }
+    }
+
+    util::ConfigureThreadPlacement(placements, automatic);
+    return valid;
+}
+
+bool CoreWrapper::IsThreadPlacementApplied() {
+    return util::IsThreadPlacementApplied();
+}
+
 void CoreWrapper::SetDeinterlacingMode(const char* mode) {
     if (!m_initialized || !m_saturn || !mode) {
         return;
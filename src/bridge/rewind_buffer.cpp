@@ -0,0 +1,295 @@
+// Brimir - Core-managed rewind history
+// Copyright (C) 2025 coredds
+// Licensed under GPL-3.0
+
+#include "brimir/rewind_buffer.hpp"
+
+#include <ymir/util/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <lz4.h>
+
+namespace brimir {
+
+namespace {
+
+// Encoded record: [blockCount:4] followed by one [storedSize:4] per block and then the stored bytes of every block.
+// A stored size of zero means the block is all zeros; kRawBlock marks blocks stored as-is.
+constexpr size_t kBlockSize = 64 * 1024;
+constexpr uint32_t kRawBlock = 1u << 31u;
+
+size_t GetBlockCount(size_t size) {
+    return (size + kBlockSize - 1) / kBlockSize;
+}
+
+size_t GetStoredSize(uint32_t blockSize) {
+    return blockSize & ~kRawBlock;
+}
+
+bool IsZero(const uint8_t* data, size_t size) {
+    uint64_t acc = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        acc |= word;
+    }
+    for (; i < size; ++i) {
+        acc |= data[i];
+    }
+    return acc == 0;
+}
+
+} // namespace
+
+RewindBuffer::RewindBuffer(util::ThreadPool& pool, size_t capacity, size_t keyframeInterval)
+    : m_pool(pool)
+    , m_keyframeInterval(std::max<size_t>(keyframeInterval, 1))
+    , m_capacity(capacity)
+    , m_ring(std::make_unique_for_overwrite<uint8_t[]>(capacity)) {}
+
+bool RewindBuffer::Push(std::vector<uint8_t>& image) {
+    bool keyframe = m_records.empty() || m_framesSinceKeyframe + 1 >= m_keyframeInterval;
+    size_t encodedSize = keyframe ? Encode(image.data(), image.size(), nullptr, 0)
+                                  : Encode(image.data(), image.size(), m_head.data(), m_head.size());
+    if (encodedSize > m_capacity) {
+        return false;
+    }
+
+    size_t offset = Reserve(encodedSize);
+    if (!keyframe && m_records.empty()) {
+        // Dropped the snapshot the delta was based on; start over from a keyframe
+        keyframe = true;
+        encodedSize = Encode(image.data(), image.size(), nullptr, 0);
+        if (encodedSize > m_capacity) {
+            m_head.clear();
+            return false;
+        }
+        offset = 0;
+    }
+
+    uint8_t* out = &m_ring[offset];
+    const uint32_t blockCount = static_cast<uint32_t>(m_blockSizes.size());
+    std::memcpy(out, &blockCount, 4);
+    std::memcpy(out + 4, m_blockSizes.data(), blockCount * 4);
+    out += 4 + blockCount * 4;
+    for (size_t i = 0; i < blockCount; ++i) {
+        const size_t storedSize = GetStoredSize(m_blockSizes[i]);
+        std::memcpy(out, m_blockBuffers[i].data(), storedSize);
+        out += storedSize;
+    }
+
+    const size_t rawSize = keyframe ? image.size() : std::max(image.size(), m_head.size());
+    m_records.push_back({offset, encodedSize, rawSize, image.size(), keyframe});
+    m_usedBytes += encodedSize;
+    m_framesSinceKeyframe = keyframe ? 0 : m_framesSinceKeyframe + 1;
+    std::swap(m_head, image);
+    return true;
+}
+
+bool RewindBuffer::Pop() {
+    if (m_records.size() < 2) {
+        return false;
+    }
+
+    const Record popped = m_records.back();
+    m_records.pop_back();
+    m_usedBytes -= popped.size;
+
+    bool ok = true;
+    if (!popped.keyframe) {
+        // XOR is its own inverse: undoing the delta on the newest snapshot yields the previous one
+        m_head.resize(popped.rawSize);
+        ok = Decode(popped, m_head.data(), true);
+        m_head.resize(m_records.back().imageSize);
+        --m_framesSinceKeyframe;
+    } else {
+        // Rebuild the previous snapshot from its keyframe. The oldest record is always a keyframe.
+        size_t start = m_records.size() - 1;
+        while (!m_records[start].keyframe) {
+            --start;
+        }
+        const Record& key = m_records[start];
+        m_head.resize(key.rawSize);
+        ok = Decode(key, m_head.data(), false);
+        for (size_t i = start + 1; ok && i < m_records.size(); ++i) {
+            const Record& delta = m_records[i];
+            m_head.resize(delta.rawSize);
+            ok = Decode(delta, m_head.data(), true);
+            m_head.resize(delta.imageSize);
+        }
+        m_framesSinceKeyframe = m_records.size() - 1 - start;
+    }
+
+    if (!ok) {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void RewindBuffer::Clear() {
+    m_records.clear();
+    m_usedBytes = 0;
+    m_framesSinceKeyframe = 0;
+    m_head.clear();
+}
+
+size_t RewindBuffer::Encode(const uint8_t* src, size_t srcSize, const uint8_t* base, size_t baseSize) {
+    const size_t rawSize = std::max(srcSize, baseSize);
+    const size_t blockCount = GetBlockCount(rawSize);
+    m_blockSizes.resize(blockCount);
+    if (m_blockBuffers.size() < blockCount) {
+        m_blockBuffers.resize(blockCount);
+    }
+
+    m_pool.ParallelFor(blockCount, [&](size_t i) {
+        const size_t begin = i * kBlockSize;
+        const size_t size = std::min(kBlockSize, rawSize - begin);
+
+        // Most blocks don't change between frames; skip staging those
+        if (base != nullptr && begin + size <= std::min(srcSize, baseSize) &&
+            std::memcmp(src + begin, base + begin, size) == 0) {
+            m_blockSizes[i] = 0;
+            return;
+        }
+
+        // Stage the block as src XOR base, both zero-extended to rawSize
+        auto& buffer = m_blockBuffers[i];
+        buffer.resize(kBlockSize + static_cast<size_t>(LZ4_compressBound(static_cast<int>(kBlockSize))));
+        uint8_t* staged = buffer.data();
+        uint8_t* packed = buffer.data() + kBlockSize;
+        const size_t srcEnd = std::clamp(srcSize, begin, begin + size) - begin;
+        const size_t baseEnd = base != nullptr ? std::clamp(baseSize, begin, begin + size) - begin : 0;
+        const size_t common = std::min(srcEnd, baseEnd);
+        for (size_t j = 0; j < common; ++j) {
+            staged[j] = src[begin + j] ^ base[begin + j];
+        }
+        if (srcEnd > common) {
+            std::memcpy(staged + common, src + begin + common, srcEnd - common);
+        } else if (baseEnd > common) {
+            std::memcpy(staged + common, base + begin + common, baseEnd - common);
+        }
+        std::fill(staged + std::max(srcEnd, baseEnd), staged + size, uint8_t{0});
+
+        if (IsZero(staged, size)) {
+            m_blockSizes[i] = 0;
+            return;
+        }
+        const int packedSize = LZ4_compress_default(reinterpret_cast<const char*>(staged),
+                                                    reinterpret_cast<char*>(packed), static_cast<int>(size),
+                                                    LZ4_compressBound(static_cast<int>(kBlockSize)));
+        if (packedSize > 0 && static_cast<size_t>(packedSize) < size) {
+            std::memmove(buffer.data(), packed, static_cast<size_t>(packedSize));
+            m_blockSizes[i] = static_cast<uint32_t>(packedSize);
+        } else {
+            m_blockSizes[i] = kRawBlock | static_cast<uint32_t>(size);
+        }
+    });
+
+    size_t encodedSize = 4 + blockCount * 4;
+    for (const uint32_t blockSize : m_blockSizes) {
+        encodedSize += GetStoredSize(blockSize);
+    }
+    return encodedSize;
+}
+
+bool RewindBuffer::Decode(const Record& record, uint8_t* dst, bool xorInto) {
+    const uint8_t* in = &m_ring[record.offset];
+    uint32_t blockCount = 0;
+    std::memcpy(&blockCount, in, 4);
+    if (blockCount != GetBlockCount(record.rawSize)) {
+        return false;
+    }
+
+    m_blockSizes.resize(blockCount);
+    std::memcpy(m_blockSizes.data(), in + 4, blockCount * 4);
+    std::vector<size_t> offsets(blockCount);
+    size_t offset = 4 + blockCount * 4;
+    for (size_t i = 0; i < blockCount; ++i) {
+        offsets[i] = offset;
+        offset += GetStoredSize(m_blockSizes[i]);
+    }
+    if (offset != record.size) {
+        return false;
+    }
+    if (xorInto && m_decodeBuffers.size() < blockCount) {
+        m_decodeBuffers.resize(blockCount);
+    }
+
+    std::atomic<bool> ok = true;
+    m_pool.ParallelFor(blockCount, [&](size_t i) {
+        const size_t begin = i * kBlockSize;
+        const size_t size = std::min(kBlockSize, record.rawSize - begin);
+        const uint32_t blockSize = m_blockSizes[i];
+        if (blockSize == 0) {
+            if (!xorInto) {
+                std::memset(dst + begin, 0, size);
+            }
+            return;
+        }
+
+        const uint8_t* stored = in + offsets[i];
+        uint8_t* out = dst + begin;
+        if (xorInto) {
+            m_decodeBuffers[i].resize(kBlockSize);
+            out = m_decodeBuffers[i].data();
+        }
+        if (blockSize & kRawBlock) {
+            if (GetStoredSize(blockSize) != size) {
+                ok = false;
+                return;
+            }
+            std::memcpy(out, stored, size);
+        } else if (LZ4_decompress_safe(reinterpret_cast<const char*>(stored), reinterpret_cast<char*>(out),
+                                       static_cast<int>(blockSize), static_cast<int>(size)) !=
+                   static_cast<int>(size)) {
+            ok = false;
+            return;
+        }
+        if (xorInto) {
+            for (size_t j = 0; j < size; ++j) {
+                dst[begin + j] ^= out[j];
+            }
+        }
+    });
+    return ok;
+}
+
+size_t RewindBuffer::Reserve(size_t size) {
+    if (m_records.empty()) {
+        return 0;
+    }
+
+    // Records are laid out oldest to newest, wrapping around at most once. Write right after the newest record, or at
+    // the start of the ring if that doesn't fit, in which case every record past the newest one is skipped over.
+    const size_t newestEnd = m_records.back().offset + m_records.back().size;
+    const bool wrap = newestEnd + size > m_capacity;
+    const size_t offset = wrap ? 0 : newestEnd;
+    while (!m_records.empty()) {
+        const Record& oldest = m_records.front();
+        const bool skipped = wrap && oldest.offset >= newestEnd;
+        const bool overlaps = oldest.offset < offset + size && offset < oldest.offset + oldest.size;
+        if (!skipped && !overlaps) {
+            break;
+        }
+        DropOldest();
+    }
+    return offset;
+}
+
+void RewindBuffer::DropOldest() {
+    // The deltas following a keyframe cannot be decoded without it
+    do {
+        m_usedBytes -= m_records.front().size;
+        m_records.pop_front();
+    } while (!m_records.empty() && !m_records.front().keyframe);
+    if (m_records.empty()) {
+        m_framesSinceKeyframe = 0;
+    }
+}
+
+} // namespace brimir
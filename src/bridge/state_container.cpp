@@ -0,0 +1,352 @@
+// Brimir - Sectioned save state container
+// Copyright (C) 2025 coredds
+// Licensed under GPL-3.0
+
+#include "brimir/state_container.hpp"
+
+#include <ymir/savestate/savestate.hpp>
+#include <ymir/util/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+
+#include <lz4.h>
+
+namespace brimir {
+
+namespace {
+
+using ymir::savestate::SaveState;
+
+constexpr uint32_t kFlagLZ4 = 1u << 0u;
+
+constexpr size_t kCountSize = 4;
+constexpr size_t kEntrySize = 16;
+
+// Generous bounds for the variable-sized sections
+constexpr size_t kMaxINTBACKReportSize = 512;
+constexpr size_t kMaxCartDataSize = 16 * 1024 * 1024;
+
+struct Range {
+    size_t offset;
+    size_t size;
+};
+
+struct Entry {
+    uint32_t id;
+    uint32_t flags;
+    uint32_t rawSize;
+    uint32_t storedSize;
+};
+
+// Byte ranges of the state covered by each section. Vector-backed sections have no ranges.
+using Layout = std::array<std::vector<Range>, static_cast<size_t>(StateSection::Count)>;
+
+template <typename T>
+Range RangeOf(const SaveState& state, const T& member) {
+    const auto* base = reinterpret_cast<const uint8_t*>(&state);
+    const auto* ptr = reinterpret_cast<const uint8_t*>(&member);
+    return {static_cast<size_t>(ptr - base), sizeof(T)};
+}
+
+Layout BuildLayout(const SaveState& state) {
+    Layout layout{};
+    auto add = [&](StateSection section, const auto& member) {
+        layout[static_cast<size_t>(section)].push_back(RangeOf(state, member));
+    };
+    add(StateSection::CPUs, state.msh2);
+    add(StateSection::CPUs, state.ssh2);
+    add(StateSection::WRAMLow, state.system.WRAMLow);
+    add(StateSection::WRAMHigh, state.system.WRAMHigh);
+    add(StateSection::VDP1VRAM, state.vdp.VRAM1);
+    add(StateSection::VDP1Framebuffers, state.vdp.spriteFB);
+    add(StateSection::VDP1MeshFramebuffers, state.vdp.renderer.vdp1State.meshFB);
+    add(StateSection::VDP2Memory, state.vdp.VRAM2);
+    add(StateSection::VDP2Memory, state.vdp.CRAM);
+    add(StateSection::SCSPWRAM, state.scsp.WRAM);
+    add(StateSection::CDBlockHLE, state.cdblock);
+    add(StateSection::CDBlockLLE, state.sh1);
+    add(StateSection::CDBlockLLE, state.ygr);
+    add(StateSection::CDBlockLLE, state.cddrive);
+    add(StateSection::CDBlockDRAM, state.cdblockDRAM);
+
+    // Everything else goes into the devices section, except for the vector objects whose contents are stored
+    // separately
+    std::vector<Range> carved{};
+    for (const auto& ranges : layout) {
+        carved.insert(carved.end(), ranges.begin(), ranges.end());
+    }
+    carved.push_back(RangeOf(state, state.scu.cartData));
+    carved.push_back(RangeOf(state, state.smpc.intback.report));
+    std::sort(carved.begin(), carved.end(), [](const Range& lhs, const Range& rhs) { return lhs.offset < rhs.offset; });
+
+    auto& devices = layout[static_cast<size_t>(StateSection::Devices)];
+    size_t pos = 0;
+    for (const Range& range : carved) {
+        if (range.offset > pos) {
+            devices.push_back({pos, range.offset - pos});
+        }
+        pos = std::max(pos, range.offset + range.size);
+    }
+    if (pos < sizeof(SaveState)) {
+        devices.push_back({pos, sizeof(SaveState) - pos});
+    }
+    return layout;
+}
+
+size_t GetLayoutSize(const std::vector<Range>& ranges) {
+    size_t size = 0;
+    for (const Range& range : ranges) {
+        size += range.size;
+    }
+    return size;
+}
+
+const std::vector<uint8_t>* GetVector(const SaveState& state, StateSection section) {
+    switch (section) {
+    case StateSection::CartData: return &state.scu.cartData;
+    case StateSection::INTBACKReport: return &state.smpc.intback.report;
+    default: return nullptr;
+    }
+}
+
+std::vector<uint8_t>* GetVector(SaveState& state, StateSection section) {
+    return const_cast<std::vector<uint8_t>*>(GetVector(std::as_const(state), section));
+}
+
+bool IsPresent(const SaveState& state, StateSection section) {
+    switch (section) {
+    case StateSection::CDBlockHLE: return !state.cdblockLLE;
+    case StateSection::CDBlockLLE: return state.cdblockLLE;
+    case StateSection::CDBlockDRAM: return state.cdblockLLE;
+    case StateSection::CartData: return !state.scu.cartData.empty();
+    case StateSection::INTBACKReport: return !state.smpc.intback.report.empty();
+    default: return true;
+    }
+}
+
+void Gather(const SaveState& state, const std::vector<Range>& ranges, uint8_t* dst) {
+    const auto* base = reinterpret_cast<const uint8_t*>(&state);
+    for (const Range& range : ranges) {
+        std::memcpy(dst, base + range.offset, range.size);
+        dst += range.size;
+    }
+}
+
+void Scatter(const uint8_t* src, const std::vector<Range>& ranges, SaveState& state) {
+    auto* base = reinterpret_cast<uint8_t*>(&state);
+    for (const Range& range : ranges) {
+        std::memcpy(base + range.offset, src, range.size);
+        src += range.size;
+    }
+}
+
+} // namespace
+
+StateContainer::StateContainer(util::ThreadPool& pool)
+    : m_pool(pool) {}
+
+size_t StateContainer::GetMaxSize(bool cdblockLLE, size_t cartDataSize) {
+    // Every section is stored at most at its raw size. The devices section takes up whatever the other sections and
+    // the vector objects leave of the state structure.
+    size_t size = sizeof(SaveState) - 2 * sizeof(std::vector<uint8_t>);
+    if (cdblockLLE) {
+        size -= sizeof(SaveState::cdblock);
+    } else {
+        size -= sizeof(SaveState::sh1) + sizeof(SaveState::ygr) + sizeof(SaveState::cddrive) +
+                sizeof(SaveState::cdblockDRAM);
+    }
+    size += cartDataSize + kMaxINTBACKReportSize;
+    return kCountSize + kNumSections * kEntrySize + size;
+}
+
+size_t StateContainer::Write(const SaveState& state, uint8_t* out, size_t capacity, bool compress) {
+    const Layout layout = BuildLayout(state);
+
+    std::array<StateSection, kNumSections> sections{};
+    size_t count = 0;
+    for (size_t i = 0; i < kNumSections; ++i) {
+        const auto section = static_cast<StateSection>(i);
+        if (IsPresent(state, section) || (!compress && GetVector(state, section) != nullptr)) {
+            sections[count++] = static_cast<StateSection>(i);
+        }
+    }
+
+    std::array<Entry, kNumSections> entries{};
+    std::array<const uint8_t*, kNumSections> payloads{};
+
+    m_pool.ParallelFor(count, [&](size_t i) {
+        const StateSection section = sections[i];
+        const size_t index = static_cast<size_t>(section);
+        const auto& ranges = layout[index];
+
+        const uint8_t* src;
+        size_t srcSize;
+        if (const auto* vec = GetVector(state, section)) {
+            src = vec->data();
+            srcSize = vec->size();
+        } else if (ranges.size() == 1) {
+            src = reinterpret_cast<const uint8_t*>(&state) + ranges[0].offset;
+            srcSize = ranges[0].size;
+        } else {
+            auto& raw = m_rawBuffers[index];
+            raw.resize(GetLayoutSize(ranges));
+            Gather(state, ranges, raw.data());
+            src = raw.data();
+            srcSize = raw.size();
+        }
+
+        int packedSize = 0;
+        auto& packed = m_packedBuffers[index];
+        if (compress) {
+            packed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(srcSize))));
+            packedSize =
+                LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(packed.data()),
+                                     static_cast<int>(srcSize), static_cast<int>(packed.size()));
+        }
+
+        Entry& entry = entries[i];
+        entry.id = static_cast<uint32_t>(section);
+        entry.rawSize = static_cast<uint32_t>(srcSize);
+        if (packedSize > 0 && static_cast<size_t>(packedSize) < srcSize) {
+            entry.flags = kFlagLZ4;
+            entry.storedSize = static_cast<uint32_t>(packedSize);
+            payloads[i] = packed.data();
+        } else {
+            // Incompressible or not compressing; store as-is
+            entry.flags = 0;
+            entry.storedSize = static_cast<uint32_t>(srcSize);
+            payloads[i] = src;
+        }
+    });
+
+    size_t totalSize = kCountSize + count * kEntrySize;
+    for (size_t i = 0; i < count; ++i) {
+        totalSize += entries[i].storedSize;
+    }
+    if (totalSize > capacity) {
+        return 0;
+    }
+
+    const uint32_t count32 = static_cast<uint32_t>(count);
+    std::memcpy(out, &count32, kCountSize);
+    uint8_t* entryOut = out + kCountSize;
+    uint8_t* dataOut = entryOut + count * kEntrySize;
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(entryOut, &entries[i], kEntrySize);
+        entryOut += kEntrySize;
+        if (entries[i].storedSize > 0) {
+            std::memcpy(dataOut, payloads[i], entries[i].storedSize);
+            dataOut += entries[i].storedSize;
+        }
+    }
+    return totalSize;
+}
+
+bool StateContainer::Read(const uint8_t* in, size_t size, SaveState& state) {
+    if (size < kCountSize) {
+        return false;
+    }
+    uint32_t count = 0;
+    std::memcpy(&count, in, kCountSize);
+    if (count == 0 || count > kNumSections || size < kCountSize + count * kEntrySize) {
+        return false;
+    }
+
+    const Layout layout = BuildLayout(state);
+
+    std::array<Entry, kNumSections> entries{};
+    std::array<const uint8_t*, kNumSections> payloads{};
+    std::array<bool, kNumSections> found{};
+    size_t dataOffset = kCountSize + count * kEntrySize;
+    for (size_t i = 0; i < count; ++i) {
+        Entry& entry = entries[i];
+        std::memcpy(&entry, in + kCountSize + i * kEntrySize, kEntrySize);
+        if (entry.id >= kNumSections || found[entry.id]) {
+            return false;
+        }
+        if ((entry.flags & ~kFlagLZ4) != 0 || (!(entry.flags & kFlagLZ4) && entry.storedSize != entry.rawSize)) {
+            return false;
+        }
+        if (entry.storedSize > size - dataOffset) {
+            return false;
+        }
+
+        const auto section = static_cast<StateSection>(entry.id);
+        if (GetVector(state, section) != nullptr) {
+            const size_t maxSize =
+                section == StateSection::CartData ? kMaxCartDataSize : kMaxINTBACKReportSize;
+            if (entry.rawSize > maxSize) {
+                return false;
+            }
+        } else if (entry.rawSize != GetLayoutSize(layout[entry.id])) {
+            return false;
+        }
+
+        found[entry.id] = true;
+        payloads[i] = in + dataOffset;
+        dataOffset += entry.storedSize;
+    }
+    if (!found[static_cast<size_t>(StateSection::Devices)]) {
+        return false;
+    }
+
+    // Size the vectors up front so that their sections can be decoded in place; absent vectors are empty
+    for (const StateSection section : {StateSection::CartData, StateSection::INTBACKReport}) {
+        GetVector(state, section)->clear();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (auto* vec = GetVector(state, static_cast<StateSection>(entries[i].id))) {
+            vec->resize(entries[i].rawSize);
+        }
+    }
+
+    std::atomic<bool> ok = true;
+    m_pool.ParallelFor(count, [&](size_t i) {
+        const Entry& entry = entries[i];
+        const auto section = static_cast<StateSection>(entry.id);
+        const auto& ranges = layout[entry.id];
+
+        uint8_t* dst;
+        const bool direct = GetVector(state, section) != nullptr || ranges.size() == 1;
+        if (auto* vec = GetVector(state, section)) {
+            dst = vec->data();
+        } else if (direct) {
+            dst = reinterpret_cast<uint8_t*>(&state) + ranges[0].offset;
+        } else {
+            auto& raw = m_rawBuffers[entry.id];
+            raw.resize(entry.rawSize);
+            dst = raw.data();
+        }
+
+        if (entry.flags & kFlagLZ4) {
+            const int result =
+                LZ4_decompress_safe(reinterpret_cast<const char*>(payloads[i]), reinterpret_cast<char*>(dst),
+                                    static_cast<int>(entry.storedSize), static_cast<int>(entry.rawSize));
+            if (result != static_cast<int>(entry.rawSize)) {
+                ok = false;
+                return;
+            }
+        } else if (entry.rawSize > 0) {
+            std::memcpy(dst, payloads[i], entry.rawSize);
+        }
+
+        if (!direct) {
+            Scatter(dst, ranges, state);
+        }
+    });
+    if (!ok) {
+        return false;
+    }
+
+    // The CD block flag lives in the devices section; the matching CD block sections must be there too
+    if (state.cdblockLLE) {
+        return found[static_cast<size_t>(StateSection::CDBlockLLE)] &&
+               found[static_cast<size_t>(StateSection::CDBlockDRAM)];
+    }
+    return found[static_cast<size_t>(StateSection::CDBlockHLE)];
+}
+
+} // namespace brimir
@@ -58,6 +58,31 @@ struct Configuration {
         /// Enabling this option incurs a small performance penalty and purges all SH-2 caches.
         util::Observable<bool> emulateSH2Cache = false;
 
+        /// @brief Caches pre-decoded SH-2 instructions fetched from IPL ROM and WRAM.
+        ///
+        /// Speeds up instruction fetching and decoding without changing emulation results. Only used when SH-2 cache
+        /// emulation is disabled.
+        util::Observable<bool> sh2DecodeCache = true;
+
+        /// @brief Runs SCU DSP programs in blocks of pre-decoded commands.
+        ///
+        /// Skips redundant per-cycle checks while no DSP DMA transfers are in flight without changing emulation
+        /// results. Not used when debug tracing is enabled.
+        util::Observable<bool> scuDSPBlockExecutor = true;
+
+        /// @brief Adapts the master/slave SH-2 synchronization interval to how much the CPUs interact.
+        ///
+        /// The CPUs run in long slices while they work independently and fall back to lockstep as soon as they
+        /// communicate through shared WRAM or FRT input capture. Games flagged in the database always run in lockstep.
+        util::Observable<bool> adaptiveSH2Sync = true;
+
+        /// @brief Runs the slave SH-2 on its own host thread while the CPUs work independently. Experimental.
+        ///
+        /// Only takes effect while the adaptive synchronization interval is at its maximum, with SH-2 cache emulation
+        /// and debug tracing disabled. Windows in which the CPUs interact are rolled back and re-run on one thread, so
+        /// results do not depend on host thread timing.
+        util::Observable<bool> parallelSH2 = false;
+
         /// @brief SH-2 overclock factor as a percentage (100 = 1.0x speed).
         ///
         /// Adjusts the cycle rate of the SH-2 CPUs, which may help reduce internal slowdowns
@@ -106,8 +131,24 @@ struct Configuration {
 
         /// @brief Runs the SCSP and MC68EC000 CPU in a dedicated thread.
         ///
-        /// Currently unimplemented.
+        /// The thread may run up to `scsp::kThreadSlackSamples` samples behind the emulator thread. SCU-side accesses are
+        /// applied in order and sound request interrupts changed on the thread reach the SCU that many samples late, so
+        /// the results do not depend on thread timing but are not identical to running on a single thread.
+        ///
+        /// Off by default until the "Threaded SCSP cost" benchmark shows a gain; on a single-core host a frame takes
+        /// about twice as long with the thread. Sound RAM also loses its bus fastmem entries while the thread runs.
         util::Observable<bool> threadedSCSP = false;
+
+        /// @brief Puts the MC68EC000 to sleep while it spins in idle polling loops.
+        ///
+        /// The CPU wakes up as soon as an interrupt is raised or any of the polled memory locations change.
+        util::Observable<bool> m68kIdleSkip = true;
+
+        /// @brief Runs the SCSP DSP program through pre-decoded, specialized instructions.
+        ///
+        /// The specialized program is rebuilt whenever MPRO is written to and produces the same results as the
+        /// interpreter.
+        util::Observable<bool> specializeDSP = true;
     } audio;
 
     /// @brief CD Block configuration.
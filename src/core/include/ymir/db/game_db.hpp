@@ -52,6 +52,7 @@ struct GameInfo {
         RelaxedVDP2BitmapCPAccessChecks = BIT(8), ///< Allow bitmap CP accesses during SH2 cycles
         SkipEmptyVDP1Table = BIT(9),              ///< Skip VDP1 command processing if the top of the table is empty
         VirtuaGunJitter = BIT(10),                ///< Add a bit of jitter to Virtua Gun coordinates
+        StrictSH2Sync = BIT(11),                  ///< Always run the master and slave SH-2 in lockstep
 #undef BIT
 
         // Proper fixes for each flag:
@@ -70,6 +71,8 @@ struct GameInfo {
         //   perfectly stable Virtua Gun positions. In reality, it's very unlikely to keep the aim perfectly steady at
         //   the same pixel. This adds a very small amount of jitter to the coordinates, just enough to get the affected
         //   game to register on-screen shots as shots and not reloads.
+        // - StrictSH2Sync: not a hack; it disables a speed optimization for games whose CPUs communicate in ways the
+        //   interaction heuristics cannot see.
     };
 
     Flags flags = Flags::None;        ///< Game compatibility flags
@@ -36,6 +36,16 @@ public:
 
     void SetExternalInterruptLevel(uint8 level);
 
+    // Returns the address of the next instruction word to be fetched into the prefetch queue.
+    uint32 GetPC() const {
+        return PC;
+    }
+
+    // Determines if an interrupt will be serviced before executing the next instruction.
+    bool IsInterruptPending() const {
+        return m_externalInterruptLevel == 7 || m_externalInterruptLevel > SR.IPM;
+    }
+
     // -------------------------------------------------------------------------
     // Save states
 
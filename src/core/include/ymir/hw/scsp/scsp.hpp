@@ -41,6 +41,7 @@
 #include <queue>
 #include <span>
 #include <thread>
+#include <vector>
 
 namespace ymir::scsp {
 
@@ -131,6 +132,14 @@ public:
         m_cbOutputSample = callback;
     }
 
+    /// @brief Enables or disables delivery of output samples to the sample callback.
+    /// The SCSP keeps running normally while output is disabled; only the final samples are discarded.
+    /// Must only be changed while the SCSP thread is synchronized (e.g. between frames).
+    /// @param[in] enable whether to send samples to the output callback
+    void SetSampleOutputEnabled(bool enable) {
+        m_sampleOutputEnabled = enable;
+    }
+
     void MapCallbacks(CBTriggerSoundRequestInterrupt callback) {
         m_cbTriggerSoundRequestInterrupt = callback;
     }
@@ -143,6 +152,7 @@ public:
     /// 0 means normal speed, 1 is double, 2 is quadruple, etc.
     /// @param clockShift the shift to apply to the clock speed of the MC68EC000, between 0 to 4.
     void SetCPUClockShift(uint64 clockShift) {
+        SyncSCSPThread();
         m_m68kClockShift = std::min<uint64>(clockShift, 4);
     }
 
@@ -215,6 +225,65 @@ private:
     std::atomic<uint64> m_m68kClockShift = 0ull;
     std::atomic<bool> m_m68kEnabled = false;
 
+    // MC68EC000 idle loop skipping.
+    //
+    // Short backward branches start monitoring a potential idle loop. If the loop only reads a handful of WRAM
+    // locations and reaches its head again with the exact same CPU state, it cannot make progress until one of those
+    // locations changes or an interrupt is raised, so the CPU is put to sleep until that happens.
+    static constexpr uint32 kM68KMaxIdleLoopSize = 64;
+    static constexpr uint32 kM68KMaxIdleLoopWatches = 16;
+
+    enum class M68KIdleLoopState : uint8 { Searching, Monitoring, Idle };
+
+    struct M68KIdleLoopWatch {
+        uint32 address;
+        uint16 value;
+        uint8 size;
+    };
+
+    struct M68KIdleLoop {
+        M68KIdleLoopState state;
+        bool disqualified;
+        uint32 loopPC;
+        savestate::M68KSaveState cpuState;
+        std::array<M68KIdleLoopWatch, kM68KMaxIdleLoopWatches> watches;
+        uint32 numWatches;
+
+        void Reset() {
+            state = M68KIdleLoopState::Searching;
+            disqualified = false;
+            loopPC = 0;
+            cpuState = {};
+            watches.fill({});
+            numWatches = 0;
+        }
+    } m_m68kIdleLoop;
+
+    bool m_m68kIdleSkip = true;
+
+    // Records a WRAM data read by the MC68EC000 while monitoring a potential idle loop.
+    template <mem_primitive T>
+    void M68KIdleLoopWatchRead(uint32 address, T value) {
+        auto &loop = m_m68kIdleLoop;
+        for (uint32 i = 0; i < loop.numWatches; i++) {
+            const M68KIdleLoopWatch &watch = loop.watches[i];
+            if (watch.address == address && watch.size == sizeof(T)) {
+                return;
+            }
+        }
+        if (loop.numWatches == kM68KMaxIdleLoopWatches) {
+            loop.disqualified = true;
+            return;
+        }
+        loop.watches[loop.numWatches++] = {address, value, sizeof(T)};
+    }
+
+    // Checks for idle loops after executing an instruction at prevPC.
+    void M68KIdleLoopCheck(uint32 prevPC);
+
+    // Determines if the MC68EC000 should leave the idle state.
+    bool M68KIdleLoopShouldWake();
+
     core::Scheduler &m_scheduler;
     core::EventID m_sampleTickEvent;
 
@@ -265,6 +334,7 @@ private:
     bool m_debugTracing = false;
 
     CBOutputSample m_cbOutputSample;
+    bool m_sampleOutputEnabled = true;
     CBTriggerSoundRequestInterrupt m_cbTriggerSoundRequestInterrupt;
     CBSendMidiOutputMessage m_cbSendMidiOutputMessage;
 
@@ -325,8 +395,16 @@ private:
 
         if (util::AddressInRange<0x000000, 0x07FFFF>(address)) {
             // TODO: handle memory size bit
-            return ReadWRAM<T>(address);
+            const T value = ReadWRAM<T>(address);
+            if constexpr (!instrFetch) {
+                if (m_m68kIdleLoop.state == M68KIdleLoopState::Monitoring) {
+                    M68KIdleLoopWatchRead<T>(address, value);
+                }
+            }
+            return value;
         } else if (util::AddressInRange<0x100000, 0x1FFFFF>(address)) {
+            // Register reads may have side effects or return changing values
+            m_m68kIdleLoop.disqualified = true;
             return ReadReg<T, accessType>(address & 0xFFF);
         } else {
             return 0;
@@ -335,6 +413,8 @@ private:
 
     template <mem_primitive T>
     void Write(uint32 address, T value) {
+        // Loops that write to memory or registers are not idle
+        m_m68kIdleLoop.disqualified = true;
         if (util::AddressInRange<0x000000, 0x07FFFF>(address)) {
             WriteWRAM<T>(address, value);
         } else if (util::AddressInRange<0x100000, 0x1FFFFF>(address)) {
@@ -577,7 +657,8 @@ private:
             const uint32 index = (address >> 3u) & 0x7F;
             const uint32 subindex = ((address >> 1u) & 0x3) ^ 3;
             write16(m_dsp.program[index].u16[subindex], value16);
-            m_dsp.UpdateProgramLength(index);
+            m_dsp.UpdateProgramLength();
+            m_dsp.CompileInstruction(index);
             return;
         } else if (AddressInRange<0xC00, 0xDFF>(address)) {
             // DSP TEMP
@@ -754,7 +835,6 @@ private:
 
     // --- MIDI Register ---
 
-    template <bool threaded>
     void ProcessMidiInputQueue();
     void FlushMidiOutput(bool endPacket);
 
@@ -1117,14 +1197,17 @@ private:
 
     void UpdateM68KInterrupts();
     void UpdateSCUInterrupts() {
+        const bool level = (m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0;
         if (m_threadedSCSP) {
-            m_scspInterruptLevel.store((m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0,
-                                       std::memory_order_relaxed);
+            PublishSoundRequest(level);
         } else {
-            m_cbTriggerSoundRequestInterrupt((m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0);
+            m_soundRequestLevel = level;
+            m_cbTriggerSoundRequestInterrupt(level);
         }
     }
 
+    bool m_soundRequestLevel; // Sound request level last delivered to the SCU
+
     // --- DMA Transfer Register ---
 
     bool m_dmaExec;         // (R/W) DEXE - DMA Execution
@@ -1150,7 +1233,7 @@ private:
 
     template <uint32 stepShift, bool debug>
     void TickSlots(); // Processes a single slot (16 SCSP cycles)
-    template <bool debug, bool threaded>
+    template <bool debug>
     void TickSample(); // Processes a full sample (512 SCSP cycles)
 
     void RunM68K(uint64 cycles);
@@ -1164,11 +1247,11 @@ private:
     // Emulates an entire sample's worth of cycles.
     // This executes the 7 slot operations 32 times, and all 128 DSP program steps.
     // Requires the slot counter to be aligned to 0.
-    template <bool debug, bool threaded>
+    template <bool debug>
     void StepSample();
 
     // Performs the 7 operation steps on slots from index i to i-6 (modulo 32).
-    template <bool debug, bool threaded>
+    template <bool debug>
     void ProcessSlots(uint32 i);
 
     // Advances the sample counter by one.
@@ -1345,11 +1428,32 @@ private:
     moodycamel::ProducerToken m_ptokThreadEventQueue{m_threadEventQueue};
     moodycamel::ConsumerToken m_ctokThreadEventQueue{m_threadEventQueue};
 
-    std::mutex m_cddaMutex;
-    std::mutex m_midiQueueMutex;
+    // Sound request changes made on the SCSP thread are timestamped with the event that caused them and replayed to the
+    // SCU kThreadSlackSamples samples later, on the sample tick that waits for that event. The latency is fixed, so the
+    // results do not depend on how far behind the SCSP thread runs.
+
+    // Value of m_eventsEnqueued right after each of the last kThreadSlackSamples samples was queued, oldest first
+    std::array<uint64, kThreadSlackSamples> m_sampleEvents{};
+
+    // Number of sound request level changes to deliver on each of the upcoming sample ticks, starting with the next one
+    std::array<uint16, kThreadSlackSamples + 1> m_soundRequestToggles{};
+
+    bool m_threadSoundRequestLevel = false;          // Sound request level last published by the SCSP thread
+    std::vector<uint64> m_soundRequestChanges;       // Events that changed the published level, in order
+    std::atomic<bool> m_soundRequestChanged = false; // Whether m_soundRequestChanges has entries
+    std::mutex m_soundRequestMutex;                  // Guards m_soundRequestChanges
+
+    // Publishes the sound request level from the SCSP thread.
+    void PublishSoundRequest(bool level);
 
-    std::atomic<bool> m_scspInterruptLevel{false};
-    bool m_lastSCSPInterruptLevel = false;
+    // Sorts the sound request changes published by the SCSP thread into the upcoming sample ticks.
+    void CollectSoundRequestChanges();
+
+    // Delivers the sound request changes due on this sample tick to the SCU.
+    void DeliverSoundRequests();
+
+    // Delivers all pending sound request changes to the SCU right away.
+    void FlushSoundRequests();
 
     sys::SH2Bus *m_bus = nullptr;
 
@@ -1359,12 +1463,12 @@ private:
     // Forces the emulator thread to wait until the SCSP catches up.
     void SyncSCSPThread();
 
+    // Waits until the SCSP thread has processed the given number of events.
+    void WaitForSCSPThread(uint64 target);
+
     // Stops the SCSP thread if running and waits for it to finish.
     void StopSCSPThread();
 
-    // Periodically checks and triggers sound request interrupts back to the SCU.
-    void PollSCSPInterrupts();
-
     // Queues a write operation to be applied by the SCSP thread.
     template <mem_primitive T>
     void EnqueueWrite(uint32 address, T value);
@@ -28,6 +28,10 @@ inline constexpr uint64 kM68KCyclesPerSample = kCyclesPerSample / kCyclesPerM68K
 // SCSP clock frequency: 22,579,200 Hz = 44,100 Hz * 512 cycles per sample
 inline constexpr uint64 kClockFreq = kAudioFreq * kCyclesPerSample;
 
+// Number of samples the SCSP thread may run behind the emulator thread when the SCSP is threaded.
+// Sound request interrupts raised or cleared on the SCSP thread reach the SCU this many samples late.
+inline constexpr uint64 kThreadSlackSamples = 4;
+
 // Pending interrupt flags
 inline constexpr uint16 kIntrINT0N = 0;          // External INT0N line
 inline constexpr uint16 kIntrINT1N = 1;          // External INT1N line
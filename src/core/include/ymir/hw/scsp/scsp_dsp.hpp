@@ -15,6 +15,7 @@
 #include <bit>
 #include <cassert>
 #include <iosfwd>
+#include <utility>
 
 namespace ymir::scsp {
 
@@ -55,116 +56,11 @@ public:
 
     FORCE_INLINE void Step() {
         if (PC < m_programLength) {
-            const DSPInstr instr = program[PC];
-
-            if (instr.IRA <= 0x1F) {
-                // MEMS area: 24 -> 24 bits
-                INPUTS = soundMem[instr.IRA];
-            } else if (instr.IRA <= 0x2F) {
-                // MIXS area: 20 -> 24 bits
-                INPUTS = mixStack[GetMIXSIndex(instr.IRA & 0xF) ^ 0x10] << 4;
-            } else if (instr.IRA <= 0x31) {
-                // EXTS area: 16 -> 24 bits
-                INPUTS = audioInOut[instr.IRA & 0x1] << 8;
-            }
-
-            const uint8 tempReadAddr = (instr.TRA + MDEC_CT) & 0x7F;
-            const uint8 tempWriteAddr = (instr.TWA + MDEC_CT) & 0x7F;
-
-            const sint32 inputs = INPUTS;
-            const sint32 temp = tempMem[tempReadAddr];
-
-            const sint32 xval = instr.XSEL ? inputs : temp;
-            uint16 yval;
-            switch (instr.YSEL) {
-            case 0: yval = FRC_REG; break;
-            case 1: yval = coeffs[instr.CRA]; break;
-            case 2: yval = static_cast<uint16>(bit::extract<11, 23>(Y_REG)); break;
-            case 3: yval = static_cast<uint16>(bit::extract<4, 15>(Y_REG)); break;
-            }
-
-            if (instr.YRL) {
-                Y_REG = bit::extract<0, 23>(inputs);
-            }
-
-            sint32 shifterOut = static_cast<uint32>(bit::sign_extend<26>(SFT_REG)) << (instr.SHFT0 ^ instr.SHFT1);
-            if (instr.SHFT1 == 0) {
-                shifterOut = std::clamp(shifterOut, -0x800000, 0x7FFFFF);
-            } else {
-                shifterOut = bit::sign_extend<24>(shifterOut);
-            }
-
-            if (instr.FRCL) {
-                if (instr.SHFT == 3) {
-                    FRC_REG = bit::extract<0, 11>(shifterOut);
-                } else {
-                    FRC_REG = bit::extract<11, 23>(shifterOut);
-                }
-            }
-
-            uint32 sgaOutput;
-            if (instr.ZERO) {
-                sgaOutput = 0;
+            if (specializeProgram) {
+                const CompiledInstr &instr = m_compiledProgram[PC];
+                (this->*instr.fn)(instr);
             } else {
-                if (instr.BSEL) {
-                    sgaOutput = SFT_REG;
-                } else {
-                    sgaOutput = temp;
-                }
-                if (instr.NEGB) {
-                    sgaOutput = -(sint32)sgaOutput;
-                }
-            }
-            const uint32 product = (bit::sign_extend<13, sint64>(yval) * xval) >> 12;
-            SFT_REG = (product + sgaOutput) & 0x3FFFFFF;
-
-            if (instr.EWT) {
-                effectOut[instr.EWA] = shifterOut >> 8;
-            }
-            if (instr.TWT) {
-                tempMem[tempWriteAddr] = shifterOut;
-            }
-            if (instr.IWT) {
-                soundMem[instr.IWA] = bit::sign_extend<24>(m_readValue);
-            }
-
-            if (m_readPending) {
-                uint16 tmp = ReadWRAM();
-                m_readValue = (m_readPending && m_readNOFL) ? (tmp << 8) : FloatToInt(tmp);
-                m_readPending = false;
-                m_readNOFL = false;
-            } else if (m_writePending) {
-                WriteWRAM();
-                m_writePending = false;
-            }
-
-            uint16 addr = addrs[instr.MASA] + instr.NXADR;
-
-            if (instr.ADREB) {
-                addr += bit::sign_extend<12>(ADRS_REG);
-            }
-
-            if (!instr.TABLE) {
-                addr = (addr + MDEC_CT) & m_RBL;
-            }
-
-            m_readWriteAddr = (addr + m_RBP) & 0x7FFFF;
-
-            if (instr.MRD) {
-                m_readPending = true;
-                m_readNOFL = instr.NOFL;
-            }
-            if (instr.MWT) {
-                m_writePending = true;
-                m_writeValue = instr.NOFL ? (shifterOut >> 8) : IntToFloat(shifterOut);
-            }
-
-            if (instr.ADRL) {
-                if (instr.SHFT == 3) {
-                    ADRS_REG = (shifterOut >> 12) & 0xFFF;
-                } else {
-                    ADRS_REG = (inputs >> 16) & 0xFFF;
-                }
+                Interpret(program[PC]);
             }
         } else if (m_writePending) {
             WriteWRAM();
@@ -183,10 +79,21 @@ public:
         }
     }
 
-    void UpdateProgramLength(uint8 writeIndex);
+    void UpdateProgramLength();
+
+    // Rebuilds the specialized form of the instruction at the given MPRO index.
+    // Must be invoked whenever the instruction is modified.
+    void CompileInstruction(uint8 index);
+
+    // Rebuilds the specialized form of the entire program.
+    void CompileProgram();
 
     void DumpRegs(std::ostream &out) const;
 
+    // Runs the program through pre-decoded instructions specialized on their input source, Y input select and shifter
+    // mode instead of interpreting MPRO directly. Both methods produce identical results.
+    bool specializeProgram = true;
+
     // -------------------------------------------------------------------------
     // Registers
 
@@ -282,6 +189,167 @@ private:
 
     uint8 *m_WRAM;
 
+    // -------------------------------------------------------------------------
+    // Program execution
+
+    // Sources of the INPUTS register, selected by IRA
+    enum InputsSource : uint32 { kInputsMEMS, kInputsMIXS, kInputsEXTS, kInputsNone };
+
+    // Sources of the shifter/adder input, selected by ZERO and BSEL
+    enum AdderSource : uint8 { kAdderZero, kAdderTEMP, kAdderSFT };
+
+    struct CompiledInstr;
+    using FnExecute = void (DSP::*)(const CompiledInstr &instr);
+
+    // An MPRO instruction with its fields unpacked and the handler specialized on the most branch-heavy ones
+    struct CompiledInstr {
+        FnExecute fn;
+
+        uint8 inputsAddr; // MEMS index, MIXS offset or EXTS index, depending on IRA
+        uint8 TRA;
+        uint8 TWA;
+        uint8 CRA;
+        uint8 IWA;
+        uint8 EWA;
+        uint8 MASA;
+        uint8 NXADR;
+        AdderSource adderSource;
+
+        bool XSEL;
+        bool YRL;
+        bool FRCL;
+        bool ADRL;
+        bool NEGB;
+        bool EWT;
+        bool TWT;
+        bool IWT;
+        bool MRD;
+        bool MWT;
+        bool NOFL;
+        bool ADREB;
+        bool TABLE;
+    };
+
+    alignas(64) std::array<CompiledInstr, 128> m_compiledProgram;
+
+    template <uint32 inputsSource, uint32 ysel, uint32 shft>
+    void ExecuteCompiled(const CompiledInstr &instr);
+
+    template <size_t... indices>
+    static constexpr std::array<FnExecute, sizeof...(indices)> MakeCompiledHandlers(std::index_sequence<indices...>);
+
+    FORCE_INLINE void Interpret(const DSPInstr instr) {
+        if (instr.IRA <= 0x1F) {
+            // MEMS area: 24 -> 24 bits
+            INPUTS = soundMem[instr.IRA];
+        } else if (instr.IRA <= 0x2F) {
+            // MIXS area: 20 -> 24 bits
+            INPUTS = mixStack[GetMIXSIndex(instr.IRA & 0xF) ^ 0x10] << 4;
+        } else if (instr.IRA <= 0x31) {
+            // EXTS area: 16 -> 24 bits
+            INPUTS = audioInOut[instr.IRA & 0x1] << 8;
+        }
+
+        const uint8 tempReadAddr = (instr.TRA + MDEC_CT) & 0x7F;
+        const uint8 tempWriteAddr = (instr.TWA + MDEC_CT) & 0x7F;
+
+        const sint32 inputs = INPUTS;
+        const sint32 temp = tempMem[tempReadAddr];
+
+        const sint32 xval = instr.XSEL ? inputs : temp;
+        uint16 yval;
+        switch (instr.YSEL) {
+        case 0: yval = FRC_REG; break;
+        case 1: yval = coeffs[instr.CRA]; break;
+        case 2: yval = static_cast<uint16>(bit::extract<11, 23>(Y_REG)); break;
+        case 3: yval = static_cast<uint16>(bit::extract<4, 15>(Y_REG)); break;
+        }
+
+        if (instr.YRL) {
+            Y_REG = bit::extract<0, 23>(inputs);
+        }
+
+        sint32 shifterOut = static_cast<uint32>(bit::sign_extend<26>(SFT_REG)) << (instr.SHFT0 ^ instr.SHFT1);
+        if (instr.SHFT1 == 0) {
+            shifterOut = std::clamp(shifterOut, -0x800000, 0x7FFFFF);
+        } else {
+            shifterOut = bit::sign_extend<24>(shifterOut);
+        }
+
+        if (instr.FRCL) {
+            if (instr.SHFT == 3) {
+                FRC_REG = bit::extract<0, 11>(shifterOut);
+            } else {
+                FRC_REG = bit::extract<11, 23>(shifterOut);
+            }
+        }
+
+        uint32 sgaOutput;
+        if (instr.ZERO) {
+            sgaOutput = 0;
+        } else {
+            if (instr.BSEL) {
+                sgaOutput = SFT_REG;
+            } else {
+                sgaOutput = temp;
+            }
+            if (instr.NEGB) {
+                sgaOutput = -(sint32)sgaOutput;
+            }
+        }
+        const uint32 product = (bit::sign_extend<13, sint64>(yval) * xval) >> 12;
+        SFT_REG = (product + sgaOutput) & 0x3FFFFFF;
+
+        if (instr.EWT) {
+            effectOut[instr.EWA] = shifterOut >> 8;
+        }
+        if (instr.TWT) {
+            tempMem[tempWriteAddr] = shifterOut;
+        }
+        if (instr.IWT) {
+            soundMem[instr.IWA] = bit::sign_extend<24>(m_readValue);
+        }
+
+        if (m_readPending) {
+            uint16 tmp = ReadWRAM();
+            m_readValue = (m_readPending && m_readNOFL) ? (tmp << 8) : FloatToInt(tmp);
+            m_readPending = false;
+            m_readNOFL = false;
+        } else if (m_writePending) {
+            WriteWRAM();
+            m_writePending = false;
+        }
+
+        uint16 addr = addrs[instr.MASA] + instr.NXADR;
+
+        if (instr.ADREB) {
+            addr += bit::sign_extend<12>(ADRS_REG);
+        }
+
+        if (!instr.TABLE) {
+            addr = (addr + MDEC_CT) & m_RBL;
+        }
+
+        m_readWriteAddr = (addr + m_RBP) & 0x7FFFF;
+
+        if (instr.MRD) {
+            m_readPending = true;
+            m_readNOFL = instr.NOFL;
+        }
+        if (instr.MWT) {
+            m_writePending = true;
+            m_writeValue = instr.NOFL ? (shifterOut >> 8) : IntToFloat(shifterOut);
+        }
+
+        if (instr.ADRL) {
+            if (instr.SHFT == 3) {
+                ADRS_REG = (shifterOut >> 12) & 0xFFF;
+            } else {
+                ADRS_REG = (inputs >> 16) & 0xFFF;
+            }
+        }
+    }
+
     [[nodiscard]] FORCE_INLINE uint16 ReadWRAM() const {
         const uint32 address = m_readWriteAddr * sizeof(uint16);
         if (address < 0x80000) {
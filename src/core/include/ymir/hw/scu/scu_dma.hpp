@@ -59,6 +59,8 @@ struct DMAChannel {
 
         currIndirectSrc = 0;
         endIndirect = false;
+
+        xfer = {};
     }
 
     void InitTransfer() {
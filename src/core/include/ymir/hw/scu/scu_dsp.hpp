@@ -55,7 +55,9 @@ public:
             }
         }
 
-        programRAM[PC++].u32 = value;
+        programRAM[PC].u32 = value;
+        m_decodedProgram[PC] = DecodeCommand(programRAM[PC]);
+        PC++;
     }
 
     template <bool poke>
@@ -329,6 +331,10 @@ public:
     // -------------------------------------------------------------------------
     // State
 
+    // Runs straight-line code with no DMA transfers in flight through a pre-decoded copy of program RAM without
+    // rechecking the execution state on every cycle. Produces the same results as the cycle-by-cycle interpreter.
+    bool blockExecutor = true;
+
     std::array<DSPInstr, 256> programRAM;
     std::array<std::array<uint32, 64>, 4> dataRAM;
 
@@ -397,6 +403,24 @@ private:
 
     debug::ISCUTracer *m_tracer = nullptr;
 
+    using FnCommand = void (SCUDSP::*)(DSPInstr instr);
+
+    // Command handlers for each instruction in programRAM, used by the block executor.
+    // Must be updated whenever program RAM is written to.
+    std::array<FnCommand, 256> m_decodedProgram;
+
+    static FnCommand DecodeCommand(DSPInstr instr);
+    void DecodeProgram();
+
+    // Executes the next command, running DMA transfers in parallel.
+    // Returns false if execution must be suspended due to a DMA stall.
+    template <bool debug>
+    bool StepCycle();
+
+    // Runs the program in blocks of commands executed without per-cycle state checks while there are no DMA transfers
+    // in flight.
+    void RunBlocks(uint64 cycles);
+
     void IncrementPC();
 
     // Run pending DMA transfer if the CT register is in use
@@ -417,6 +441,7 @@ private:
     void Cmd_Special_Jump(DSPInstr instr);
     void Cmd_Special_Loop(DSPInstr instr);
     void Cmd_Special_End(DSPInstr instr);
+    void Cmd_Invalid(DSPInstr instr);
 #undef TPL_DEBUG
 };
 
@@ -4,6 +4,9 @@
 #include "sh2_regs.hpp"
 
 #include "sh2_decode.hpp"
+#include "sh2_decode_cache.hpp"
+#include "sh2_speculation.hpp"
+#include "sh2_sync_monitor.hpp"
 
 #include "sh2_bsc.hpp"
 #include "sh2_cache.hpp"
@@ -62,6 +65,38 @@ public:
         m_emulateCache = &emulateCacheRef;
     }
 
+    // Uses the given decode cache to fetch and decode instructions when not emulating the SH-2 cache.
+    // Pass nullptr to fetch and decode every instruction from memory.
+    void UseDecodeCache(DecodeCache *decodeCache) {
+        m_decodeCache = decodeCache;
+    }
+
+    // Reports interactions with the other SH-2 to the given monitor.
+    // The master SH-2 records WRAM reads, the slave SH-2 checks WRAM writes against them.
+    // Pass nullptr to disable monitoring.
+    void UseSyncMonitor(SyncMonitor *syncMonitor) {
+        m_syncMonitor = syncMonitor;
+    }
+
+    // Runs this SH-2 speculatively within the given window: memory accesses are isolated from the rest of the system
+    // and external interrupts and FRT input captures are deferred. Pass nullptr to end speculation.
+    void Speculate(SpeculationWindow *window) {
+        if (window != nullptr) {
+            m_specStartCycles = m_cyclesExecuted;
+        }
+        m_specWindow = window;
+    }
+
+    // Records WRAM writes made by this SH-2 into the given window so that conflicts with the speculating SH-2 can be
+    // detected. Pass nullptr to stop recording.
+    void ObserveSpeculation(SpeculationWindow *window) {
+        m_specObserver = window;
+    }
+
+    // Applies the external events deferred during a speculation window that was rolled back to its checkpoint. The
+    // events are applied at the time the window started, just like they would have been without speculation.
+    void ReplayDeferredEvents(const SpeculationWindow &window);
+
     void UseDebugBreakManager(debug::DebugBreakManager *mgr) {
         m_debugBreakMgr = mgr;
         if (mgr != nullptr) {
@@ -87,11 +122,28 @@ public:
     /// @tparam debug whether to enable debug features
     /// @tparam emulateCache whether to emulate the cache
     /// @param[in] cycles the minimum number of cycles
+    ///
+    /// With a sync monitor attached, the master SH-2 stops early right after an access to the SCU registers so that the
+    /// SCU can catch up with it.
+    ///
     /// @param[in] spilloverCycles cycles spilled over from the previous execution
     /// @return the number of cycles actually executed
     template <bool debug, bool emulateCache>
     uint64 Advance(uint64 cycles, uint64 spilloverCycles = 0);
 
+    /// @brief Extends the last `Advance` call to at least the specified number of cycles.
+    ///
+    /// The result is the same as if the last `Advance` call had been given the new target in the first place. In
+    /// particular, timer events are not checked again.
+    ///
+    /// @tparam debug whether to enable debug features
+    /// @tparam emulateCache whether to emulate the cache
+    /// @param[in] cycles the new minimum number of cycles
+    /// @param[in] executedCycles the cycles returned by the last `Advance` call
+    /// @return the number of cycles actually executed
+    template <bool debug, bool emulateCache>
+    uint64 Resume(uint64 cycles, uint64 executedCycles);
+
     // Executes a single instruction.
     // Returns the number of cycles executed.
     template <bool debug, bool emulateCache>
@@ -692,6 +744,21 @@ private:
     // Advance and Step always honor the `emulateCache` template flag.
     const bool *m_emulateCache = &kNilEmulateCache;
 
+    // Pre-decoded instruction cache shared with the other SH-2, or nullptr if disabled.
+    DecodeCache *m_decodeCache = nullptr;
+
+    // Monitor of interactions with the other SH-2, or nullptr if disabled.
+    SyncMonitor *m_syncMonitor = nullptr;
+
+    // Speculation window this SH-2 is running in, or nullptr if not speculating.
+    SpeculationWindow *m_specWindow = nullptr;
+
+    // Value of m_cyclesExecuted when the current speculation window started.
+    uint64 m_specStartCycles = 0;
+
+    // Speculation window recording writes made by this SH-2, or nullptr if the other SH-2 is not speculating.
+    SpeculationWindow *m_specObserver = nullptr;
+
     // -------------------------------------------------------------------------
     // Cycle counting
 
@@ -703,6 +770,16 @@ private:
     // Number of cycles executed in the current Advance invocation
     uint64 m_cyclesExecuted;
 
+    // Number of cycles the current Advance invocation runs for; lowered to end it early
+    uint64 m_cycleTarget = 0;
+
+    // Whether the last Advance invocation skipped execution because the CPU was sleeping
+    bool m_sleptThroughAdvance = false;
+
+    // Executes instructions until m_cyclesExecuted reaches m_cycleTarget
+    template <bool debug, bool emulateCache>
+    void Execute();
+
     // Retrieves the current absolute cycle count
     uint64 GetCurrentCycleCount() const;
 
@@ -764,11 +841,27 @@ private:
     template <mem_primitive T, bool poke, bool debug, bool emulateCache>
     void MemWrite(uint32 address, T value);
 
+    // Reports an access to the SCU registers to the sync monitor.
+    // The master SH-2 also ends the current Advance invocation after the instruction so that the SCU runs DMA transfers
+    // and DSP programs started by it at the same granularity as lockstep execution.
+    void CheckSCUAccess(uint32 address) {
+        if (SyncMonitor::IsSCURegister(address)) [[unlikely]] {
+            m_syncMonitor->SignalInteraction();
+            if (IsMaster()) {
+                m_cycleTarget = 0;
+            }
+        }
+    }
+
     template <bool emulateCache>
     uint16 FetchInstruction(uint32 address);
     template <bool emulateCache>
     void RefillPipeline();
 
+    // Fetches and decodes the instruction at the given address through the decode cache.
+    // Leaves the pipeline in the same state as FetchInstruction<false>.
+    OpcodeType FetchDecodedInstruction(uint32 address, uint16 &instr);
+
     template <bool emulateCache>
     uint8 MemReadByte(uint32 address);
     template <bool emulateCache, bool instrFetch = false>
@@ -807,6 +900,9 @@ private:
     template <mem_primitive T, bool write, bool emulateCache>
     uint64 AccessCycles(uint32 address);
 
+    // Determines if the given access is blocked, going through the speculation window if there is one.
+    bool IsBusWait(uint32 address, uint32 size, bool write);
+
     template <bool emulateCache>
     uint64 AccessCyclesRMWByte(uint32 address);
 
@@ -897,6 +993,10 @@ private:
 
     void TriggerFRTInputCapture();
 
+    // Catches up the WDT and FRT only if they may have reached an overflow or compare match.
+    // Register accesses advance the timers on demand.
+    void AdvanceTimers();
+
     // -------------------------------------------------------------------------
     // Interrupts
 
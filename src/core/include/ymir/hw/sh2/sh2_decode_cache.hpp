@@ -0,0 +1,146 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::sh2::DecodeCache`, a cache of pre-decoded SH-2 instructions.
+*/
+
+#include "sh2_decode.hpp"
+
+#include <ymir/sys/bus.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/inline.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace ymir::sh2 {
+
+/// @brief A pre-decoded SH-2 instruction.
+struct DecodedInstruction {
+    uint16 instr;                      ///< Raw instruction word
+    std::array<OpcodeType, 2> opcode;  ///< Decoded opcode: [0] regular, [1] delay slot
+    bool valid;                        ///< Whether this entry matches the current memory contents
+
+    /// @brief Decodes the given instruction word into this entry.
+    /// @param[in] value the raw instruction word
+    FORCE_INLINE void Decode(uint16 value) {
+        instr = value;
+        opcode[0] = DecodeTable::s_instance.opcodes[0][value];
+        opcode[1] = DecodeTable::s_instance.opcodes[1][value];
+        valid = true;
+    }
+};
+
+/// @brief Caches pre-decoded SH-2 instructions by physical memory block.
+///
+/// Blocks are built on first execution and shared by every mirror of the underlying memory. The cache registers itself
+/// as the bus array write callback; writes through the bus to tracked pages invalidate the affected entries, so valid
+/// entries always match the contents of memory.
+///
+/// Only memory regions added with `AddRegion` are cached. Those regions must be array-backed and must only be written
+/// through the bus, otherwise the cache must be flushed manually.
+class DecodeCache {
+public:
+    static constexpr uint32 kBlockBits = 12;
+    static constexpr uint32 kBlockSize = 1u << kBlockBits;
+    static constexpr uint32 kBlockMask = kBlockSize - 1;
+    static constexpr uint32 kBlockEntries = kBlockSize / sizeof(uint16);
+
+    explicit DecodeCache(sys::SH2Bus &bus);
+    ~DecodeCache();
+
+    DecodeCache(const DecodeCache &) = delete;
+    DecodeCache &operator=(const DecodeCache &) = delete;
+
+    /// @brief Allows instructions in the specified bus address range to be cached.
+    /// @param[in] start the lower bound of the address range
+    /// @param[in] end the upper bound of the address range
+    void AddRegion(uint32 start, uint32 end);
+
+    /// @brief Invalidates all cached entries.
+    ///
+    /// Must be invoked whenever cached memory is modified without going through the bus, such as when loading save
+    /// states or ROM images.
+    void Flush();
+
+    /// @brief Invalidates the entries that no longer match the contents of memory.
+    ///
+    /// An alternative to `Flush()` for when cached memory was replaced without going through the bus but most of it is
+    /// likely unchanged, such as when restoring a save state taken a few frames earlier. Entries of unmodified code stay
+    /// valid.
+    void Revalidate();
+
+    /// @brief Invalidates the entries covering the specified bus address range.
+    /// @param[in] address the bus address of the write
+    /// @param[in] size the size of the write in bytes
+    FORCE_INLINE void Invalidate(uint32 address, uint32 size) {
+        Block *block = m_blocks[(address & kAddressMask) >> kBlockBits];
+        if (block == nullptr) {
+            return;
+        }
+        const uint32 index = (address & kBlockMask) >> 1u;
+        block->entries[index].valid = false;
+        if (size == sizeof(uint32)) {
+            block->entries[index + 1].valid = false;
+        }
+    }
+
+    /// @brief Looks up the cache entry for the instruction at the given address.
+    ///
+    /// Allocates the block on first use. The entry may be invalid; callers must check `valid` and decode the
+    /// instruction if needed. The entry of the second instruction of an aligned 32-bit pair always immediately follows
+    /// the entry of the first.
+    ///
+    /// @param[in] address the instruction address with bits 31-29 (the cache partition) cleared
+    /// @return a pointer to the entry, or `nullptr` if the address cannot be cached
+    FORCE_INLINE DecodedInstruction *Lookup(uint32 address) {
+        address &= kAddressMask;
+        Block *block = m_blocks[address >> kBlockBits];
+        if (block == nullptr) [[unlikely]] {
+            block = AllocateBlock(address);
+            if (block == nullptr) {
+                return nullptr;
+            }
+        }
+        if (block->generation != m_generation) [[unlikely]] {
+            block->Clear(m_generation);
+        }
+        return &block->entries[(address & kBlockMask) >> 1u];
+    }
+
+private:
+    static constexpr uint32 kAddressMask = 0x7FFFFFF;
+    static constexpr uint32 kBlockCount = (kAddressMask + 1) >> kBlockBits;
+
+    struct Block {
+        alignas(64) std::array<DecodedInstruction, kBlockEntries> entries;
+        uint64 generation;
+        uint32 address; // Bus address of the first mirror this block was built for
+
+        void Clear(uint64 newGeneration);
+    };
+
+    struct Region {
+        uint32 start;
+        uint32 end;
+    };
+
+    sys::SH2Bus &m_bus;
+
+    std::vector<Region> m_regions;
+
+    // Blocks indexed by bus address; mirrors point to the same block
+    std::array<Block *, kBlockCount> m_blocks;
+    std::vector<std::unique_ptr<Block>> m_blockStorage;
+
+    // Blocks with a different generation are stale and cleared on their next lookup
+    uint64 m_generation = 0;
+
+    Block *AllocateBlock(uint32 address);
+};
+
+} // namespace ymir::sh2
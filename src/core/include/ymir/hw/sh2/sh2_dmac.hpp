@@ -18,6 +18,10 @@ enum class DMAResourceSelect : uint8 { DREQ, RXI, TXI, Reserved };
 
 struct DMAChannel {
     DMAChannel() {
+        // SAR, DAR and TCR are undefined after a reset and keep their values
+        srcAddress = 0;
+        dstAddress = 0;
+        xferCount = 0;
         Reset();
     }
 
@@ -7,7 +7,9 @@
 #include <ymir/util/bit_ops.hpp>
 #include <ymir/util/inline.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace ymir::sh2 {
 
@@ -33,6 +35,13 @@ struct FreeRunningTimer {
 
         m_cycleCount = 0;
         m_clockDividerShift = kDividerShifts[TCR.CKSn];
+        UpdateNextEvent();
+    }
+
+    // Determines if the counter may reach an overflow or compare match by the specified cycle count.
+    // The timer only needs to be advanced when this returns true or before its registers are accessed.
+    [[nodiscard]] FORCE_INLINE bool IsEventDue(uint64 cycles) const {
+        return cycles >= m_nextEventCycle;
     }
 
     // Advances the cycle counter to the specified amount
@@ -76,6 +85,7 @@ struct FreeRunningTimer {
             }
         }
         FRC = nextFRC;
+        UpdateNextEvent();
 
         return event;
     }
@@ -227,6 +237,7 @@ struct FreeRunningTimer {
     FORCE_INLINE void WriteFRCH(uint8 value) {
         if constexpr (poke) {
             bit::deposit_into<8, 15>(FRC, value);
+            UpdateNextEvent();
         } else {
             TEMP = value;
         }
@@ -239,6 +250,7 @@ struct FreeRunningTimer {
         } else {
             FRC = value | (TEMP << 8u);
         }
+        UpdateNextEvent();
     }
 
     // 014  R/W  8        FF        OCRA/B H  Output compare register A/B H
@@ -265,6 +277,7 @@ struct FreeRunningTimer {
     FORCE_INLINE void WriteOCRH(uint8 value) {
         if constexpr (poke) {
             bit::deposit_into<8, 15>(CurrOCR(), value);
+            UpdateNextEvent();
         } else {
             TEMP = value;
         }
@@ -277,6 +290,7 @@ struct FreeRunningTimer {
         } else {
             CurrOCR() = value | (TEMP << 8u);
         }
+        UpdateNextEvent();
     }
 
     // 016  R/W  8        00        TCR       Timer control register
@@ -317,11 +331,13 @@ struct FreeRunningTimer {
         TCR.CKSn = bit::extract<0, 1>(value);
 
         m_clockDividerShift = kDividerShifts[TCR.CKSn];
+        UpdateNextEvent();
     }
 
     FORCE_INLINE void WriteTCR_CKSn(uint8 value) {
         TCR.CKSn = bit::extract<0, 1>(value);
         m_clockDividerShift = kDividerShifts[TCR.CKSn];
+        UpdateNextEvent();
     }
 
     // 017  R/W  8        E0        TOCR      Timer output compare control register
@@ -339,6 +355,7 @@ struct FreeRunningTimer {
 
         void Reset() {
             OCRS = false;
+            unused = 0;
             OLVLA = false;
             OLVLB = false;
         }
@@ -432,6 +449,7 @@ struct FreeRunningTimer {
         TEMP = state.TEMP;
         m_cycleCount = state.cycleCount;
         FTCSR.mask = state.FTCSR_mask;
+        UpdateNextEvent();
     }
 
 private:
@@ -440,6 +458,22 @@ private:
 
     uint64 m_cycleCount;
     uint64 m_clockDividerShift; // derived from TCR.CKS
+
+    // Earliest cycle count at which AdvanceTo() may overflow the counter or hit a compare match.
+    // Between events the counter increments linearly, so advancing in one go yields the same state as advancing in
+    // several smaller steps.
+    uint64 m_nextEventCycle;
+
+    FORCE_INLINE void UpdateNextEvent() {
+        if (m_clockDividerShift >= 64) {
+            m_nextEventCycle = std::numeric_limits<uint64>::max();
+            return;
+        }
+        uint64 steps = 0x10000 - FRC;
+        steps = std::min<uint64>(steps, static_cast<uint16>(OCRA - FRC) + 1u);
+        steps = std::min<uint64>(steps, static_cast<uint16>(OCRB - FRC) + 1u);
+        m_nextEventCycle = ((m_cycleCount >> m_clockDividerShift) + steps) << m_clockDividerShift;
+    }
 };
 
 } // namespace ymir::sh2
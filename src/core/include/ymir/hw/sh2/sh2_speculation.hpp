@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::sh2::SpeculationWindow` and `ymir::sh2::SpeculativeRunner`, used to run the slave SH-2 on a
+separate host thread.
+*/
+
+#include "sh2_sync_monitor.hpp"
+
+#include <ymir/sys/bus.hpp>
+
+#include <ymir/hw/hw_defs.hpp>
+
+#include <ymir/savestate/savestate_sh2.hpp>
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/data_ops.hpp>
+#include <ymir/util/inline.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ymir::sh2 {
+
+class SH2;
+
+/// @brief Isolates the memory accesses of an SH-2 running speculatively alongside the other SH-2.
+///
+/// The speculating CPU reads IPL ROM and WRAM directly and writes WRAM into private shadow pages; its writes are logged
+/// and only reach memory when the window is committed. Accesses to any other memory abort the window. The other CPU
+/// records the WRAM pages it writes to. External events targeting the speculating CPU are deferred.
+///
+/// The result of a committed window matches running the other CPU for the whole window first and the speculating CPU
+/// afterwards. This holds as long as the other CPU did not write to any page the speculating CPU accessed and no event
+/// was deferred; otherwise the window is in conflict and must be discarded.
+///
+/// Reads from pages the other CPU writes to concurrently may observe torn values. Those pages always cause a conflict,
+/// so such values never make it into a committed window.
+class SpeculationWindow {
+public:
+    /// @brief An external event deferred during speculation.
+    struct DeferredEvent {
+        enum class Type : uint8 { ExternalInterrupt, InputCapture };
+
+        Type type;
+        uint8 level;
+        uint8 vector;
+    };
+
+    explicit SpeculationWindow(sys::SH2Bus &bus);
+
+    /// @brief Starts a new window, discarding all logs.
+    void Begin();
+
+    /// @brief Reads memory on behalf of the speculating CPU.
+    /// @tparam T the data type of the access
+    /// @param[in] address the bus address
+    /// @return the value read, or zero if the access aborted the window
+    template <mem_primitive T>
+    FORCE_INLINE T Read(uint32 address) {
+        const uint32 page = SyncMonitor::PageIndex(address);
+        if (page == SyncMonitor::kNoPage) [[unlikely]] {
+            if ((address & 0x7FFFFFF) <= kIPLEnd) {
+                // IPL ROM never changes
+                return m_bus.Read<T>(address);
+            }
+            m_aborted = true;
+            return 0;
+        }
+        Mark(m_readPages, page);
+        if (const uint8 *shadow = m_shadowPages[page]) {
+            return util::ReadBE<T>(&shadow[address & kPageMask]);
+        }
+        return m_bus.Read<T>(address);
+    }
+
+    /// @brief Writes memory on behalf of the speculating CPU.
+    /// @tparam T the data type of the access
+    /// @param[in] address the bus address
+    /// @param[in] value the value to write
+    template <mem_primitive T>
+    FORCE_INLINE void Write(uint32 address, T value) {
+        const uint32 page = SyncMonitor::PageIndex(address);
+        if (page == SyncMonitor::kNoPage) [[unlikely]] {
+            m_aborted = true;
+            return;
+        }
+        Mark(m_writtenPages, page);
+        uint8 *shadow = m_shadowPages[page];
+        if (shadow == nullptr) [[unlikely]] {
+            shadow = AllocateShadowPage(page, address);
+        }
+        util::WriteBE<T>(&shadow[address & kPageMask], value);
+        m_writeLog.push_back({address, value, sizeof(T)});
+    }
+
+    /// @brief Checks for bus wait states on behalf of the speculating CPU.
+    ///
+    /// Wait states reported by device handlers depend on device state owned by the other thread, so querying them
+    /// aborts the window.
+    ///
+    /// @param[in] address the bus address
+    /// @return `false`; the access proceeds unless the window was aborted
+    FORCE_INLINE bool IsBusWait(uint32 address) {
+        if (m_bus.HasBusWaitHandler(address)) [[unlikely]] {
+            m_aborted = true;
+        }
+        return false;
+    }
+
+    /// @brief Discards the window because the speculating CPU reached an operation that cannot be isolated.
+    FORCE_INLINE void Abort() {
+        m_aborted = true;
+    }
+
+    /// @brief Records a write made by the other CPU.
+    /// @param[in] address the bus address of the write
+    FORCE_INLINE void RecordWrite(uint32 address) {
+        const uint32 page = SyncMonitor::PageIndex(address);
+        if (page != SyncMonitor::kNoPage) {
+            Mark(m_otherWrittenPages, page);
+        }
+    }
+
+    /// @brief Defers an external event targeting the speculating CPU.
+    /// @param[in] event the event to defer
+    void Defer(DeferredEvent event) {
+        m_deferredEvents.push_back(event);
+    }
+
+    /// @brief Determines if the speculating CPU accessed memory outside of WRAM and IPL ROM.
+    /// @return `true` if the window was aborted
+    [[nodiscard]] FORCE_INLINE bool IsAborted() const {
+        return m_aborted;
+    }
+
+    /// @brief Determines if the window must be discarded.
+    /// @return `true` if the window was aborted, events were deferred or the CPUs accessed the same pages
+    [[nodiscard]] bool HasConflict() const;
+
+    /// @brief Writes the logged writes of the speculating CPU to memory through the bus, in order.
+    void Commit();
+
+    /// @brief Retrieves the events deferred during this window.
+    /// @return the deferred events in the order they happened
+    [[nodiscard]] const std::vector<DeferredEvent> &GetDeferredEvents() const {
+        return m_deferredEvents;
+    }
+
+private:
+    static constexpr uint32 kIPLEnd = 0x00F'FFFF;
+    static constexpr uint32 kPageSize = 1u << SyncMonitor::kPageBits;
+    static constexpr uint32 kPageMask = kPageSize - 1;
+
+    using PageSet = std::array<uint64, SyncMonitor::kPageCount / 64>;
+    using ShadowPage = std::array<uint8, kPageSize>;
+
+    struct LoggedWrite {
+        uint32 address;
+        uint32 value;
+        uint32 size;
+    };
+
+    FORCE_INLINE static void Mark(PageSet &set, uint32 page) {
+        set[page >> 6u] |= 1ull << (page & 63u);
+    }
+
+    uint8 *AllocateShadowPage(uint32 page, uint32 address);
+
+    sys::SH2Bus &m_bus;
+
+    PageSet m_readPages;
+    PageSet m_writtenPages;
+    PageSet m_otherWrittenPages;
+
+    // Shadow copies of the pages written by the speculating CPU, indexed by page
+    std::array<uint8 *, SyncMonitor::kPageCount> m_shadowPages;
+    std::vector<std::unique_ptr<ShadowPage>> m_shadowPool;
+    std::vector<uint32> m_shadowedPages;
+
+    std::vector<LoggedWrite> m_writeLog;
+    std::vector<DeferredEvent> m_deferredEvents;
+    bool m_aborted;
+};
+
+/// @brief Runs the slave SH-2 on a worker thread while the master SH-2 runs on the calling thread.
+///
+/// Every window starts from a checkpoint of the slave SH-2. Conflicting windows are rolled back to the checkpoint and
+/// must be run again serially; committed windows leave the system in the same state as running the master SH-2 first
+/// and the slave SH-2 afterwards. Either way, the outcome does not depend on host thread timing.
+///
+/// Only supports the non-debug, uncached interpreter. The slave SH-2 must not use the decode cache during a window.
+class SpeculativeRunner {
+public:
+    SpeculativeRunner(SH2 &master, SH2 &slave, sys::SH2Bus &bus);
+    ~SpeculativeRunner();
+
+    SpeculativeRunner(const SpeculativeRunner &) = delete;
+    SpeculativeRunner &operator=(const SpeculativeRunner &) = delete;
+
+    /// @brief Starts or stops the worker thread.
+    /// @param[in] enabled whether to run windows in parallel
+    void SetEnabled(bool enabled);
+
+    /// @brief Determines if the worker thread is running.
+    /// @return `true` if windows can be started
+    [[nodiscard]] bool IsEnabled() const {
+        return m_enabled;
+    }
+
+    /// @brief Starts running the slave SH-2 on the worker thread.
+    /// @param[in] cycles the cycle target, as in `SH2::Advance`
+    /// @param[in] spilloverCycles the spillover cycles, as in `SH2::Advance`
+    void Start(uint64 cycles, uint64 spilloverCycles);
+
+    /// @brief Waits for the worker thread to finish the window, then commits or rolls it back.
+    ///
+    /// On a rollback, the slave SH-2 is restored to the checkpoint and deferred events are applied to it.
+    ///
+    /// @param[out] slaveCycles receives the cycles executed by the slave SH-2 if the window was committed
+    /// @return `true` if the window was committed, `false` if it was rolled back
+    bool Finish(uint64 &slaveCycles);
+
+private:
+    SH2 &m_master;
+    SH2 &m_slave;
+    SpeculationWindow m_window;
+    savestate::SH2SaveState m_checkpoint;
+
+    bool m_enabled = false;
+    std::thread m_thread;
+    std::atomic<uint64> m_requested = 0;
+    std::atomic<uint64> m_completed = 0;
+    std::atomic<bool> m_quit = false;
+
+    // Window parameters and result, handed over through m_requested and m_completed
+    uint64 m_cycles = 0;
+    uint64 m_spilloverCycles = 0;
+    uint64 m_result = 0;
+
+    void WorkerLoop();
+};
+
+} // namespace ymir::sh2
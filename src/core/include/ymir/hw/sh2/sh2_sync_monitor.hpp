@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::sh2::SyncMonitor`, a detector of interactions between the master and slave SH-2.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <ymir/util/inline.hpp>
+
+#include <array>
+
+namespace ymir::sh2 {
+
+/// @brief Detects when the master and slave SH-2 communicate with each other.
+///
+/// The master SH-2 marks the WRAM pages it reads from and the slave SH-2 checks the pages it writes to. A slave write
+/// to a page the master read since the last check counts as an interaction, as does any FRT input capture or FTCSR
+/// access on either CPU. Accesses to the SCU registers also count, since the SCU only catches up with the CPUs at the
+/// end of each slice.
+///
+/// The system uses this to decide how tightly the two CPUs must be interleaved.
+class SyncMonitor {
+public:
+    static constexpr uint32 kPageBits = 10;
+    static constexpr uint32 kPagesPerWRAM = (1u << 20u) >> kPageBits;
+    static constexpr uint32 kPageCount = kPagesPerWRAM * 2;
+    static constexpr uint32 kNoPage = ~0u;
+
+    /// @brief Determines which WRAM page contains the given address.
+    ///
+    /// Low WRAM maps to pages [0, kPagesPerWRAM) and high WRAM to [kPagesPerWRAM, kPageCount), including mirrors and
+    /// the cache-through area.
+    ///
+    /// @param[in] address the bus address
+    /// @return the page index, or `kNoPage` if the address is not in WRAM
+    FORCE_INLINE static uint32 PageIndex(uint32 address) {
+        address &= 0x7FFFFFF;
+        if ((address >> 20u) == 0x02) {
+            return (address & 0xFFFFF) >> kPageBits;
+        }
+        if ((address >> 25u) == 0x3) {
+            return kPagesPerWRAM + ((address & 0xFFFFF) >> kPageBits);
+        }
+        return kNoPage;
+    }
+
+    /// @brief Determines whether the given address is in the SCU register area.
+    /// @param[in] address the bus address
+    /// @return `true` if the address maps to the SCU registers
+    FORCE_INLINE static bool IsSCURegister(uint32 address) {
+        return (address & 0x7FF0000) == 0x5FE0000;
+    }
+
+    /// @brief Marks the page containing the given address as read by the master SH-2.
+    /// @param[in] address the bus address of the read
+    FORCE_INLINE void MarkRead(uint32 address) {
+        const uint32 page = PageIndex(address);
+        if (page != kNoPage) {
+            m_readPages[page >> 6u] |= 1ull << (page & 63u);
+        }
+    }
+
+    /// @brief Flags an interaction if the page containing the given address was read by the master SH-2.
+    /// @param[in] address the bus address of the write
+    FORCE_INLINE void CheckWrite(uint32 address) {
+        const uint32 page = PageIndex(address);
+        if (page != kNoPage && (m_readPages[page >> 6u] >> (page & 63u)) & 1u) {
+            m_interaction = true;
+        }
+    }
+
+    /// @brief Flags an interaction unconditionally.
+    FORCE_INLINE void SignalInteraction() {
+        m_interaction = true;
+    }
+
+    /// @brief Checks whether an interaction happened since the last call and starts a new monitoring window.
+    /// @return `true` if the CPUs interacted with each other
+    bool ConsumeInteraction() {
+        const bool interaction = m_interaction;
+        m_interaction = false;
+        m_readPages.fill(0);
+        return interaction;
+    }
+
+    /// @brief Clears all monitoring state.
+    void Reset() {
+        m_interaction = false;
+        m_readPages.fill(0);
+    }
+
+private:
+    std::array<uint64, kPageCount / 64> m_readPages{};
+    bool m_interaction = false;
+};
+
+} // namespace ymir::sh2
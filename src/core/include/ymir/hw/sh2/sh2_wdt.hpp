@@ -8,6 +8,7 @@
 #include <ymir/util/inline.hpp>
 
 #include <cassert>
+#include <limits>
 
 namespace ymir::sh2 {
 
@@ -29,6 +30,13 @@ struct WatchdogTimer {
 
         m_cycleCount = 0;
         m_clockDividerShift = kDividerShifts[WTCSR.CKSn];
+        UpdateNextEvent();
+    }
+
+    // Determines if the counter may overflow by the specified cycle count.
+    // The timer only needs to be advanced when this returns true or before its registers are accessed.
+    [[nodiscard]] FORCE_INLINE bool IsEventDue(uint64 cycles) const {
+        return cycles >= m_nextEventCycle;
     }
 
     // Advances the cycle counter to the specified amount
@@ -64,6 +72,7 @@ struct WatchdogTimer {
             }
         }
         WTCNT = nextCount;
+        UpdateNextEvent();
 
         return event;
     }
@@ -145,6 +154,7 @@ struct WatchdogTimer {
         }
 
         m_clockDividerShift = kDividerShifts[WTCSR.CKSn];
+        UpdateNextEvent();
     }
 
     // 081  R    8        00        WTCNT   Watchdog Timer Counter
@@ -163,6 +173,7 @@ struct WatchdogTimer {
     FORCE_INLINE void WriteWTCNT(uint8 value) {
         if (WTCSR.TME) {
             WTCNT = value;
+            UpdateNextEvent();
         }
     }
 
@@ -241,6 +252,7 @@ struct WatchdogTimer {
         WriteWTCNT(state.WTCNT);
         WriteRSTCSR<true>(state.RSTCSR);
         m_cycleCount = state.cycleCount;
+        UpdateNextEvent();
     }
 
 private:
@@ -249,6 +261,19 @@ private:
 
     uint64 m_cycleCount;
     uint64 m_clockDividerShift; // derived from WTCSR.CKS
+
+    // Earliest cycle count at which AdvanceTo() may overflow the counter.
+    // The timer must be advanced before enabling it, so a disabled timer never needs to catch up.
+    uint64 m_nextEventCycle;
+
+    FORCE_INLINE void UpdateNextEvent() {
+        if (!WTCSR.TME) {
+            m_nextEventCycle = std::numeric_limits<uint64>::max();
+            return;
+        }
+        const uint64 steps = 0x100 - WTCNT;
+        m_nextEventCycle = ((m_cycleCount >> m_clockDividerShift) + steps) << m_clockDividerShift;
+    }
 };
 
 } // namespace ymir::sh2
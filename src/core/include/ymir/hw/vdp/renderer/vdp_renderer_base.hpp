@@ -58,6 +58,22 @@ public:
         UpdateEnhancements();
     }
 
+    /// @brief Enables or disables shadow frame mode.
+    ///
+    /// While in shadow frame mode, the renderer keeps all emulated state (including the VDP1 framebuffer) up to date,
+    /// but skips VDP2 composition and does not deliver the frame to the frontend. Used by runahead and fast-forward to
+    /// run frames whose output will never be presented.
+    /// @param[in] shadow whether to render shadow frames
+    void SetShadowFrame(bool shadow) {
+        m_shadowFrame = shadow;
+    }
+
+    /// @brief Determines if the renderer is currently in shadow frame mode.
+    /// @return `true` if VDP2 composition and frame output are being skipped
+    [[nodiscard]] bool IsShadowFrame() const {
+        return m_shadowFrame;
+    }
+
 protected:
     /// @brief Updates enhancement configurations.
     virtual void UpdateEnhancements() {}
@@ -267,6 +283,9 @@ protected:
     /// Updated automatically whenever the enhancements are changed.
     bool m_hasEnhancements = false;
 
+    /// @brief Whether the current frame is a shadow frame (see `SetShadowFrame(bool)`).
+    bool m_shadowFrame = false;
+
 private:
     const VDPRendererType m_type;
 };
@@ -91,6 +91,7 @@ struct VRAMFetcher {
         currChar = {};
         nextChar = {};
         lastCharIndex = 0xFFFFFFFF;
+        lastCellX = 0xFF;
 
         charData.fill(0);
         charDataAddress = 0xFFFFFFFF;
@@ -26,6 +26,7 @@
 
 #include <array>
 #include <atomic>
+#include <bit>
 #include <span>
 #include <thread>
 #include <type_traits>
@@ -87,6 +88,19 @@ public:
         m_threadedDeinterlacer = enable;
     }
 
+    /// @brief Specialized rendering paths. Each one produces the same output as the generic code it replaces, which
+    /// is still used when the path is disabled so that the two can be compared.
+    struct FastPaths {
+        bool vdp1LineKernels = true;  ///< Draw textured lines with kernels specialized for the draw mode
+        bool vdp1SpriteBlit = true;   ///< Copy normal sprites that need no clipping straight into the framebuffer
+        bool vdp2ScrollSpans = true;  ///< Draw NBG lines advancing whole dots per pixel one cell row at a time
+        bool vdp2RotationSIMD = true; ///< Compute rotation screen and sprite coordinates with SIMD kernels
+        bool vdp2WindowMasks = true;  ///< Combine window areas into the per-line masks a word at a time
+    };
+
+    /// @brief Specialized rendering paths in use.
+    FastPaths fastPaths;
+
     // -------------------------------------------------------------------------
     // Save states
 
@@ -397,6 +411,7 @@ private:
         union {
             struct {
                 uint32 vcnt;
+                bool render;
             } drawLine;
 
             struct {
@@ -441,8 +456,8 @@ private:
             return {Type::VDP2UpdateEnabledBGs};
         }
 
-        static VDP2RenderEvent VDP2DrawLine(uint32 vcnt) {
-            return {Type::VDP2DrawLine, {.drawLine = {.vcnt = vcnt}}};
+        static VDP2RenderEvent VDP2DrawLine(uint32 vcnt, bool render) {
+            return {Type::VDP2DrawLine, {.drawLine = {.vcnt = vcnt, .render = render}}};
         }
 
         static VDP2RenderEvent VDP2EndFrame() {
@@ -580,6 +595,7 @@ private:
     void VDP2RenderThread();
     void VDP2DeinterlaceRenderThread();
 
+    std::array<uint8, kVDP1VRAMSize> &VDP1GetRendererVRAM();
     std::array<uint8, kVDP2VRAMSize> &VDP2GetRendererVRAM();
 
     template <mem_primitive T>
@@ -622,6 +638,25 @@ private:
 
     uint16 m_VDP1doubleV;
 
+    // Color calculation performed when plotting a VDP1 pixel.
+    // Dynamic reads the operation, gouraud shading and mesh settings from the draw mode of each pixel.
+    enum class VDP1PixelOp : uint8 { Dynamic, Replace, Shadow, HalfLuminance, HalfTransparency, MSBOn };
+
+    static constexpr VDP1PixelOp VDP1GetPixelOp(VDP1Command::DrawMode mode) {
+        if (mode.msbOn) {
+            return VDP1PixelOp::MSBOn;
+        }
+        switch (mode.colorCalcBits) {
+        case 0: return VDP1PixelOp::Replace;
+        case 1: return VDP1PixelOp::Shadow;
+        case 2: return VDP1PixelOp::HalfLuminance;
+        default: return VDP1PixelOp::HalfTransparency;
+        }
+    }
+
+    // Applies a color calculation operation other than MSB-on to a pixel.
+    static Color555 VDP1CalcPixelColor(VDP1PixelOp op, Color555 srcColor, Color555 dstColor);
+
     struct VDP1PixelParams {
         VDP1Command::DrawMode mode;
         uint16 color;
@@ -680,12 +715,31 @@ private:
     // Should return true if at least one pixel of the line is inside the system + user clipping areas, regardless of
     // transparency, mesh, end codes, etc.
 
-    TPL_TRAITS bool VDP1PlotPixel(CoordS32 coord, const VDP1PixelParams &pixelParams, const VDP1Regs &regs1,
-                                  bool doubleDensity);
+    template <bool deinterlace, bool transparentMeshes, VDP1PixelOp pixelOp = VDP1PixelOp::Dynamic,
+              bool gouraud = false, bool mesh = false>
+    bool VDP1PlotPixel(CoordS32 coord, const VDP1PixelParams &pixelParams, const VDP1Regs &regs1, bool doubleDensity);
     TPL_LINE_TRAITS bool VDP1PlotLine(CoordS32 coord1, CoordS32 coord2, VDP1LineParams &lineParams,
                                       const VDP1Regs &regs1, bool doubleDensity);
-    TPL_TRAITS bool VDP1PlotTexturedLine(CoordS32 coord1, CoordS32 coord2, VDP1TexturedLineParams &lineParams,
-                                         const VDP1Regs &regs1, bool doubleDensity);
+
+    // Textured line kernels are specialized for the color mode, color calculation, gouraud shading and mesh settings
+    // of the draw mode. The kernel is selected once per command. The generic kernel, with a Dynamic pixel operation,
+    // reads all of them from the draw mode instead.
+    template <bool deinterlace, bool transparentMeshes, uint8 colorMode, VDP1PixelOp pixelOp, bool gouraud, bool mesh>
+    bool VDP1PlotTexturedLine(CoordS32 coord1, CoordS32 coord2, VDP1TexturedLineParams &lineParams,
+                              const VDP1Regs &regs1, bool doubleDensity);
+
+    using FnVDP1PlotTexturedLine = bool (SoftwareVDPRenderer::*)(CoordS32 coord1, CoordS32 coord2,
+                                                                 VDP1TexturedLineParams &lineParams,
+                                                                 const VDP1Regs &regs1, bool doubleDensity);
+
+    TPL_TRAITS static FnVDP1PlotTexturedLine VDP1SelectTexturedLineKernel(VDP1Command::DrawMode mode);
+
+    // Draws a normal sprite by copying texel rows straight into the framebuffer.
+    // Only handles sprites that lie entirely within the clipping areas and draw without gouraud shading or meshes.
+    // Returns false without drawing anything if the sprite needs to go through VDP1PlotTexturedQuad.
+    template <bool transparentMeshes>
+    bool VDP1BlitNormalSprite(uint32 cmdAddress, VDP1Command::Control control, VDP1Command::Size size, sint32 x,
+                              sint32 y);
     TPL_TRAITS void VDP1PlotTexturedQuad(uint32 cmdAddress, VDP1Command::Control control, VDP1Command::Size size,
                                          CoordS32 coordA, CoordS32 coordB, CoordS32 coordC, CoordS32 coordD);
 
@@ -721,6 +775,58 @@ private:
         OneWordExtended, // 1 word characters with extended character data; H/V flip unavailable
     };
 
+    // Per-pixel flags for a scanline, one bit per pixel. Bits past the horizontal resolution are unspecified.
+    struct PixelMask {
+        static constexpr uint32 kNumWords = (kMaxResH + 63) / 64;
+
+        // Returns the bits of word `index` that cover pixels [start, end).
+        FORCE_INLINE static uint64 RangeBits(uint32 index, uint32 start, uint32 end) {
+            const uint32 base = index * 64u;
+            if (start >= end || end <= base || start >= base + 64u) {
+                return 0;
+            }
+            const uint32 lo = start > base ? start - base : 0u;
+            const uint32 hi = end < base + 64u ? end - base : 64u;
+            return (hi == 64u ? ~0ull : (1ull << hi) - 1ull) & (~0ull << lo);
+        }
+
+        FORCE_INLINE bool operator[](uint32 x) const {
+            return (words[x >> 6u] >> (x & 63u)) & 1u;
+        }
+
+        FORCE_INLINE void Set(uint32 x, bool value) {
+            const uint64 bit = 1ull << (x & 63u);
+            words[x >> 6u] = (words[x >> 6u] & ~bit) | (value ? bit : 0ull);
+        }
+
+        void Fill(bool value) {
+            words.fill(value ? ~0ull : 0ull);
+        }
+
+        // Finds the first pixel in [start, end) whose state is `value`, or `end` if there are none.
+        FORCE_INLINE uint32 Find(bool value, uint32 start, uint32 end) const {
+            for (uint32 i = start >> 6u; i < kNumWords && i * 64u < end; i++) {
+                const uint64 bits = (value ? words[i] : ~words[i]) & RangeBits(i, start, end);
+                if (bits != 0) {
+                    return i * 64u + std::countr_zero(bits);
+                }
+            }
+            return end;
+        }
+
+        // Determines if any pixel in [start, end) is set.
+        FORCE_INLINE bool Any(uint32 start, uint32 end) const {
+            return Find(true, start, end) != end;
+        }
+
+        // Determines if all pixels in [start, end) are set.
+        FORCE_INLINE bool All(uint32 start, uint32 end) const {
+            return Find(false, start, end) == end;
+        }
+
+        alignas(16) std::array<uint64, kNumWords> words;
+    };
+
     // Common pixel data: color, priority and special color calculation flag.
     struct Pixel {
         Color888 color;
@@ -731,7 +837,7 @@ private:
     struct Pixels {
         alignas(16) std::array<Color888, kMaxResH> color;
         alignas(16) std::array<uint8, kMaxResH> priority;
-        alignas(16) std::array<bool, kMaxResH> specialColorCalc; // also used as palette/RGB indicator in sprite layer
+        PixelMask specialColorCalc; // also used as palette/RGB indicator in sprite layer
 
         FORCE_INLINE Pixel GetPixel(size_t index) const {
             return Pixel{
@@ -743,17 +849,17 @@ private:
         FORCE_INLINE void SetPixel(size_t index, Pixel pixel) {
             color[index] = pixel.color;
             priority[index] = pixel.priority;
-            specialColorCalc[index] = pixel.specialColorCalc;
+            specialColorCalc.Set(index, pixel.specialColorCalc);
         }
         FORCE_INLINE void CopyPixel(size_t src, size_t dst) {
             color[dst] = color[src];
             priority[dst] = priority[src];
-            specialColorCalc[dst] = specialColorCalc[src];
+            specialColorCalc.Set(dst, specialColorCalc[src]);
         }
     };
 
     // Layer output, containing the pixel output for the current scanline.
-    struct alignas(4096) LayerOutput {
+    struct alignas(64) LayerOutput {
         LayerOutput() {
             Reset();
         }
@@ -761,7 +867,7 @@ private:
         void Reset() {
             pixels.color.fill({});
             pixels.priority.fill({});
-            pixels.specialColorCalc.fill(false);
+            pixels.specialColorCalc.Fill(false);
         }
 
         alignas(16) Pixels pixels;
@@ -775,23 +881,23 @@ private:
 
         void Reset() {
             colorCalcRatio.fill(0);
-            shadowOrWindow.fill(false);
+            shadowOrWindow.Fill(false);
             specialType.fill(SpriteData::Special::Normal);
-            window.fill(false);
+            window.Fill(false);
         }
 
         void CopyAttrs(size_t src, size_t dst) {
             colorCalcRatio[dst] = colorCalcRatio[src];
-            shadowOrWindow[dst] = shadowOrWindow[src];
+            shadowOrWindow.Set(dst, shadowOrWindow[src]);
             specialType[dst] = specialType[src];
             // window is computed separately
         }
 
         alignas(16) std::array<uint8, kMaxResH> colorCalcRatio;
-        alignas(16) std::array<bool, kMaxResH> shadowOrWindow;
+        PixelMask shadowOrWindow;
         alignas(16) std::array<SpriteData::Special, kMaxResH> specialType;
 
-        alignas(16) std::array<bool, kMaxResH> window;
+        PixelMask window;
     };
 
     // Scanline output for Rotation Parameters A and B.
@@ -880,24 +986,24 @@ private:
     std::array<RotationParamLineOutput, 2> m_rotParamLineOutputs;
 
     // Line colors per RBG per pixel.
-    std::array<std::array<Color888, kMaxNormalResH>, 2> m_rbgLineColors;
+    std::array<std::array<Color888, kMaxNormalResH>, 2> m_rbgLineColors{};
 
-    // Window state for NBGs and RBGs.
+    // Window state for NBGs and RBGs. A set bit means the pixel is inside the window.
     // Entry [0] is primary and [1] is alternate field for deinterlacing.
     // [0] RBG0
     // [1] NBG0/RBG1
     // [2] NBG1/EXBG
     // [3] NBG2
     // [4] NBG3
-    alignas(16) std::array<std::array<std::array<bool, kMaxResH>, 5>, 2> m_bgWindows;
+    std::array<std::array<PixelMask, 5>, 2> m_bgWindows;
 
     // Window state for rotation parameters.
     // Entry [0] is primary and [1] is alternate field for deinterlacing.
-    alignas(16) std::array<std::array<bool, kMaxResH>, 2> m_rotParamsWindow;
+    std::array<PixelMask, 2> m_rotParamsWindow;
 
     // Window state for color calculation.
     // Entry [0] is primary and [1] is alternate field for deinterlacing.
-    alignas(16) std::array<std::array<bool, kMaxResH>, 2> m_colorCalcWindow;
+    std::array<PixelMask, 2> m_colorCalcWindow;
 
     // Pre-allocated buffers for VDP2ComposeLine.
     // NOTE: These are stored as member variables to avoid stack overflow on threads with limited stack space
@@ -994,20 +1100,21 @@ private:
     // altField selects the complementary field when rendering deinterlaced frames
     template <bool altField, bool hasSpriteWindow>
     void VDP2CalcWindow(uint32 y, const VDP2Regs &regs2, const WindowSet<hasSpriteWindow> &windowSet,
-                        std::span<bool> windowState);
+                        PixelMask &windowState);
 
     // Precalculates window state for a given set of parameters using AND or OR logic.
     //
     // y is the scanline to draw
     // regs2 is a reference to the set of VDP2 registers to use
     // windowSet contains the windows
-    // windowState is the window state output
+    // windowState is the window state output: a PixelMask combined a word at a time, or one bool per pixel combined a
+    // pixel at a time when the vdp2WindowMasks fast path is disabled
     //
     // altField selects the complementary field when rendering deinterlaced frames
     // logicOR determines if the windows should be combined with OR logic (true) or AND logic (false)
-    template <bool altField, bool logicOR, bool hasSpriteWindow>
+    template <bool altField, bool logicOR, bool hasSpriteWindow, typename WindowState>
     void VDP2CalcWindowLogic(uint32 y, const VDP2Regs &regs2, const WindowSet<hasSpriteWindow> &windowSet,
-                             std::span<bool> windowState);
+                             WindowState &windowState);
 
     // Prepares the specified VDP2 scanline for rendering.
     //
@@ -1116,7 +1223,28 @@ private:
               bool deinterlace>
     void VDP2DrawNormalScrollBG(const VDP2Regs &regs2, const BGParams &bgParams, LayerOutput &layerOut,
                                 const NBGLayerState &bgState, VRAMFetcher &vramFetcher,
-                                std::span<const bool> windowState, bool altField);
+                                const PixelMask &windowState, bool altField);
+
+    // Draws a normal scroll BG scanline that advances a whole number of dots per pixel, without mosaic or vertical cell
+    // scrolling. Pixels are drawn in spans sharing the same cell row, resolving the character and cell once per span.
+    //
+    // regs2 is a reference to the set of VDP2 registers to use
+    // bgParams contains the parameters for the BG to draw.
+    // layerOut is a reference to the layer output for the background.
+    // vramFetcher is the corresponding background layer's VRAM fetcher.
+    // windowState is a reference to the window state for the layer.
+    // fracScrollX is the horizontal scroll coordinate of the first pixel, advanced past the last pixel on return.
+    // scrollIncH is the horizontal scroll increment in 11.8 fixed-point format. The fractional part must be zero.
+    // scrollY is the integer vertical scroll coordinate of the line.
+    //
+    // charMode indicates if character patterns use two words or one word with standard or extended character data.
+    // fourCellChar indicates if character patterns are 1x1 cells (false) or 2x2 cells (true).
+    // colorFormat is the color format for cell data.
+    // colorMode is the CRAM color mode.
+    template <CharacterMode charMode, bool fourCellChar, ColorFormat colorFormat, uint32 colorMode>
+    void VDP2DrawScrollBGSpans(const VDP2Regs &regs2, const BGParams &bgParams, LayerOutput &layerOut,
+                               VRAMFetcher &vramFetcher, const PixelMask &windowState, uint32 &fracScrollX,
+                               uint32 scrollIncH, uint32 scrollY);
 
     // Draws a normal bitmap BG scanline.
     //
@@ -1135,7 +1263,7 @@ private:
     template <ColorFormat colorFormat, uint32 colorMode, bool useVCellScroll, bool deinterlace>
     void VDP2DrawNormalBitmapBG(const VDP2Regs &regs2, const BGParams &bgParams, LayerOutput &layerOut,
                                 const NBGLayerState &bgState, VRAMFetcher &vramFetcher,
-                                std::span<const bool> windowState, bool altField);
+                                const PixelMask &windowState, bool altField);
 
     // Draws a rotation scroll BG scanline.
     //
@@ -1153,7 +1281,7 @@ private:
     // colorMode is the CRAM color mode.
     template <uint32 bgIndex, CharacterMode charMode, bool fourCellChar, ColorFormat colorFormat, uint32 colorMode>
     void VDP2DrawRotationScrollBG(const VDP2Regs &regs2, const BGParams &bgParams, LayerOutput &layerOut,
-                                  VRAMFetcher &vramFetcher, std::span<const bool> windowState, bool altField);
+                                  VRAMFetcher &vramFetcher, const PixelMask &windowState, bool altField);
 
     // Draws a rotation bitmap BG scanline.
     //
@@ -1168,7 +1296,7 @@ private:
     // colorMode is the CRAM color mode.
     template <uint32 bgIndex, ColorFormat colorFormat, uint32 colorMode>
     void VDP2DrawRotationBitmapBG(const VDP2Regs &regs2, const BGParams &bgParams, LayerOutput &layerOut,
-                                  std::span<const bool> windowState, bool altField);
+                                  const PixelMask &windowState, bool altField);
 
     // Stores the line color for the specified pixel of the RBG.
     //
@@ -1224,6 +1352,22 @@ private:
                                  std::span<const uint32> pageBaseAddresses, uint32 pageShiftH, uint32 pageShiftV,
                                  CoordU32 scrollCoord, VRAMFetcher &vramFetcher);
 
+    // Location of a dot within the character pattern held by a VRAM fetcher.
+    struct CharacterDot {
+        CoordU32 dotCoord; // Coordinates of the dot within the cell, ranging from 0 to 7
+        uint32 cellIndex;  // Index of the cell in the character pattern, ranging from 0 to 3
+    };
+
+    // Locates the character pattern at the given scroll screen coordinates and sends it through the VRAM fetcher's
+    // character pipeline, fetching it from VRAM if it differs from the last one.
+    //
+    // Takes the same parameters as VDP2FetchScrollBGPixel.
+    // Returns the location of the dot within vramFetcher.currChar.
+    template <bool rot, CharacterMode charMode, bool fourCellChar, ColorFormat colorFormat>
+    CharacterDot VDP2FetchScrollBGCharacter(const BGParams &bgParams, std::span<const uint32> pageBaseAddresses,
+                                            uint32 pageShiftH, uint32 pageShiftV, CoordU32 scrollCoord,
+                                            VRAMFetcher &vramFetcher);
+
     // Fetches a two-word character from VRAM.
     //
     // bgParams contains the parameters for the BG to draw.
@@ -1268,6 +1412,28 @@ private:
     Pixel VDP2FetchCharacterPixel(const BGParams &bgParams, const VDP2Regs &regs2, VRAMFetcher &vramFetcher,
                                   CoordU32 dotCoord, uint32 cellIndex);
 
+    // Applies the character's flip bits to the dot coordinates and computes the VRAM address of the cell they land in.
+    //
+    // bgParams contains the parameters for the BG to draw.
+    // ch is the character pattern.
+    // dotCoord specify the coordinates of the pixel within the cell, ranging from 0 to 7. Flipped in place.
+    // cellIndex is the index of the cell in the character pattern, ranging from 0 to 3.
+    //
+    // colorFormat is the value of CHCTLA/CHCTLB.xxCHCNn.
+    template <ColorFormat colorFormat>
+    uint32 VDP2CalcCellAddress(const BGParams &bgParams, const Character &ch, CoordU32 &dotCoord, uint32 cellIndex);
+
+    // Determines if every dot in a row of a cell is transparent.
+    // Cells in VRAM banks without character pattern access read as zeroes, like in VDP2FetchPixel.
+    //
+    // bgParams contains the parameters for the BG to draw.
+    // cellAddress is the VRAM address of the cell, as computed by VDP2CalcCellAddress.
+    // dotY is the row within the cell, ranging from 0 to 7.
+    //
+    // colorFormat is the value of CHCTLA/CHCTLB.xxCHCNn.
+    template <ColorFormat colorFormat>
+    bool VDP2IsCellRowTransparent(const BGParams &bgParams, uint32 cellAddress, uint32 dotY);
+
     // Fetches a bitmap pixel at the given coordinates.
     //
     // bgParams contains the parameters for the BG to draw.
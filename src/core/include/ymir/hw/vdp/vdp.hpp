@@ -171,6 +171,13 @@ public:
         m_renderer->ConfigureEnhancements(m_enhancements);
     }
 
+    /// @brief Enables or disables shadow frame mode on the renderer.
+    /// Shadow frames advance all emulated state but skip VDP2 composition and frame output.
+    /// @param[in] shadow whether to render shadow frames
+    void SetShadowFrame(bool shadow) {
+        m_renderer->SetShadowFrame(shadow);
+    }
+
     // Enable or disable VDP1 drawing stall on VRAM writes.
     void SetStallVDP1OnVRAMWrites(bool enable) {
         m_stallVDP1OnVRAMWrites = enable;
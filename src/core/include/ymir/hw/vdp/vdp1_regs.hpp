@@ -38,6 +38,7 @@ struct VDP1Regs {
 
         currCommandAddress = 0;
         prevCommandAddress = 0;
+        nextCommandAddress = 0;
 
         returnAddress = kVDP1NoReturn;
 
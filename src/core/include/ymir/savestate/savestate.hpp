@@ -52,6 +52,7 @@ struct SaveState {
     // Execution state
     uint64 msh2SpilloverCycles;
     uint64 ssh2SpilloverCycles;
+    uint64 sh2SyncStep;
     uint64 sh1SpilloverCycles;
     uint64 sh1FracCycles;
 };
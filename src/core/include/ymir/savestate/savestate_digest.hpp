@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+@file
+@brief Defines `ymir::savestate::StateDigest`, a compact fingerprint of the emulated system state.
+*/
+
+#include <ymir/core/types.hpp>
+
+#include <array>
+#include <optional>
+
+namespace ymir::savestate {
+
+/// @brief XXH3 digests of the emulated system state, one per component.
+///
+/// Two systems that went through the same sequence of inputs must produce identical digests regardless of threading
+/// settings. Comparing components individually pinpoints which part of the system diverged first.
+struct StateDigest {
+    /// @brief The components hashed separately.
+    enum class Component : uint8 {
+        Timing,    ///< Scheduler and CPU spillover cycles
+        System,    ///< System clocks, work RAM and cartridge
+        MasterSH2, ///< Master SH-2 registers, on-chip modules and cache
+        SlaveSH2,  ///< Slave SH-2 registers, on-chip modules and cache
+        SCU,       ///< SCU registers, DMA and DSP
+        SMPC,      ///< SMPC registers and RTC
+        VDP,       ///< VDP1 and VDP2 registers and memory
+        SCSP,      ///< SCSP registers, sound RAM, DSP and MC68EC000
+        CDBlock,   ///< CD block, either high-level or low-level
+
+        Count
+    };
+
+    static constexpr size_t kNumComponents = static_cast<size_t>(Component::Count);
+
+    std::array<uint64, kNumComponents> components{};
+
+    /// @brief Retrieves the digest of the given component.
+    /// @param[in] component the component
+    /// @return the XXH3 digest of the component's state
+    [[nodiscard]] uint64 Get(Component component) const {
+        return components[static_cast<size_t>(component)];
+    }
+
+    /// @brief Combines all component digests into a single value.
+    /// @return a digest covering the whole system state
+    [[nodiscard]] uint64 Combined() const;
+
+    /// @brief Finds the first component whose digest differs from the other digest.
+    /// @param[in] other the digest to compare against
+    /// @return the first mismatching component, or `std::nullopt` if both digests are equal
+    [[nodiscard]] std::optional<Component> FirstMismatch(const StateDigest &other) const {
+        for (size_t i = 0; i < kNumComponents; ++i) {
+            if (components[i] != other.components[i]) {
+                return static_cast<Component>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool operator==(const StateDigest &) const = default;
+
+    /// @brief Retrieves a human-readable name for the given component.
+    /// @param[in] component the component
+    /// @return the component name
+    static const char *GetComponentName(Component component);
+};
+
+} // namespace ymir::savestate
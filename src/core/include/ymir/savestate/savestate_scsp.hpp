@@ -6,6 +6,7 @@
 #include "savestate_scsp_timer.hpp"
 
 #include <ymir/hw/m68k/m68k_defs.hpp>
+#include <ymir/hw/scsp/scsp_defs.hpp>
 #include <ymir/hw/scsp/scsp_midi_defs.hpp>
 
 #include <ymir/core/types.hpp>
@@ -14,6 +15,21 @@
 
 namespace ymir::savestate {
 
+struct SCSPM68KIdleLoopSaveState {
+    struct Watch {
+        uint32 address;
+        uint16 value;
+        uint8 size;
+    };
+
+    uint8 state;
+    bool disqualified;
+    uint32 loopPC;
+    M68KSaveState cpuState;
+    std::array<Watch, 16> watches;
+    uint32 numWatches;
+};
+
 struct SCSPSaveState {
     alignas(16) std::array<uint8, m68k::kM68KWRAMSize> WRAM;
 
@@ -25,6 +41,7 @@ struct SCSPSaveState {
     M68KSaveState m68k;
     uint64 m68kSpilloverCycles;
     bool m68kEnabled;
+    SCSPM68KIdleLoopSaveState m68kIdleLoop;
 
     alignas(16) std::array<SCSPSlotSaveState, 32> slots;
 
@@ -46,6 +63,8 @@ struct SCSPSaveState {
     // HACK to preserve old savestate behavior which was missing SCILV.
     // Causes SCSP to reuse current SCILV settings instead of loading from save state.
     bool reuseSCILV;
+    bool soundRequestLevel;
+    std::array<uint16, ymir::scsp::kThreadSlackSamples + 1> soundRequestToggles;
 
     bool DEXE;
     bool DDIR;
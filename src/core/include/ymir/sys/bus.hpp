@@ -32,6 +32,9 @@ using FnWrite32 = void (*)(uint32 address, uint32 value, void *ctx); ///< Functi
 /// @brief Function signature for bus wait checks.
 using FnBusWait = bool (*)(uint32 address, uint32 size, bool write, void *ctx);
 
+/// @brief Function signature for write notifications on tracked array-backed pages.
+using FnArrayWrite = void (*)(uint32 address, uint32 size, void *ctx);
+
 /// @brief Specifies valid bus handler function types.
 /// @tparam T the type to check
 template <typename T>
@@ -48,6 +51,12 @@ concept bus_handler_fn =
 /// `Map` methods assign read/write functions to a range of addresses. `MapNormal` refers to the regular `Read`/`Write`
 /// functions and `MapSideEffectFree` refers to the `Peek`/`Poke` variants. `Unmap` clears the assignments.
 ///
+/// Pages mapped with `MapArray` are also entered into fastmem tables of host pointers, one for reads and one for writes.
+/// Each table has an entry for every page, like the page table itself, but entries are 8 bytes instead of 256, so the
+/// SH-2 bus tables take 16 KiB each instead of 512 KiB. Accesses to those pages are resolved with a single table lookup
+/// and a direct load or store, without touching the page handlers. Pages mapped with handlers, such as sound RAM while
+/// the SCSP runs on its own thread, have no fastmem entry.
+///
 /// @tparam addressBits number of valid address bits
 template <uint32 addressBits, uint32 pageGranularityBits>
 class Bus {
@@ -126,6 +135,8 @@ public:
         const uint32 endIndex = end >> pageGranularityBits;
         for (uint32 i = startIndex; i <= endIndex; i++) {
             m_pages[i] = {};
+            m_fastRead[i] = nullptr;
+            m_fastWrite[i] = nullptr;
         }
     }
 
@@ -154,6 +165,8 @@ public:
             m_pages[i] = {}; // clear all handlers
             m_pages[i].array = &array[offset & kMask];
             m_pages[i].arrayWritable = writable;
+            m_fastRead[i] = m_pages[i].array;
+            m_fastWrite[i] = writable ? m_pages[i].array : nullptr;
             offset += kPageSize;
         }
     }
@@ -169,11 +182,12 @@ public:
     FLATTEN FORCE_INLINE T Read(uint32 address) const {
         address &= kAddressMask & ~(sizeof(T) - 1);
 
-        const MemoryPage &entry = m_pages[address >> pageGranularityBits];
-
-        if (entry.array) {
-            return util::ReadBE<T>(&entry.array[address & kPageMask]);
+        const uint32 pageIndex = address >> pageGranularityBits;
+        if (const uint8 *fastmem = m_fastRead[pageIndex]) [[likely]] {
+            return util::ReadBE<T>(&fastmem[address & kPageMask]);
         }
+
+        const MemoryPage &entry = m_pages[pageIndex];
         if constexpr (std::is_same_v<T, uint8>) {
             return entry.read8(address, entry.ctx);
         } else if constexpr (std::is_same_v<T, uint16>) {
@@ -194,11 +208,20 @@ public:
     FLATTEN FORCE_INLINE void Write(uint32 address, T value) {
         address &= kAddressMask & ~(sizeof(T) - 1);
 
-        const MemoryPage &entry = m_pages[address >> pageGranularityBits];
+        const uint32 pageIndex = address >> pageGranularityBits;
+        if (uint8 *fastmem = m_fastWrite[pageIndex]) [[likely]] {
+            util::WriteBE<T>(&fastmem[address & kPageMask], value);
+            return;
+        }
+
+        const MemoryPage &entry = m_pages[pageIndex];
 
         if (entry.array) {
             if (entry.arrayWritable) {
                 util::WriteBE<T>(&entry.array[address & kPageMask], value);
+                if (entry.writeTracked) [[unlikely]] {
+                    m_arrayWriteFn(address, sizeof(T), m_arrayWriteCtx);
+                }
             }
             return;
         }
@@ -222,11 +245,12 @@ public:
     FLATTEN FORCE_INLINE T Peek(uint32 address) const {
         address &= kAddressMask & ~(sizeof(T) - 1);
 
-        const MemoryPage &entry = m_pages[address >> pageGranularityBits];
-
-        if (entry.array) {
-            return util::ReadBE<T>(&entry.array[address & kPageMask]);
+        const uint32 pageIndex = address >> pageGranularityBits;
+        if (const uint8 *fastmem = m_fastRead[pageIndex]) [[likely]] {
+            return util::ReadBE<T>(&fastmem[address & kPageMask]);
         }
+
+        const MemoryPage &entry = m_pages[pageIndex];
         if constexpr (std::is_same_v<T, uint8>) {
             return entry.peek8(address, entry.ctx);
         } else if constexpr (std::is_same_v<T, uint16>) {
@@ -247,11 +271,20 @@ public:
     FLATTEN FORCE_INLINE void Poke(uint32 address, T value) {
         address &= kAddressMask & ~(sizeof(T) - 1);
 
-        const MemoryPage &entry = m_pages[address >> pageGranularityBits];
+        const uint32 pageIndex = address >> pageGranularityBits;
+        if (uint8 *fastmem = m_fastWrite[pageIndex]) [[likely]] {
+            util::WriteBE<T>(&fastmem[address & kPageMask], value);
+            return;
+        }
+
+        const MemoryPage &entry = m_pages[pageIndex];
 
         if (entry.array) {
             if (entry.arrayWritable) {
                 util::WriteBE<T>(&entry.array[address & kPageMask], value);
+                if (entry.writeTracked) [[unlikely]] {
+                    m_arrayWriteFn(address, sizeof(T), m_arrayWriteCtx);
+                }
             }
             return;
         }
@@ -283,6 +316,73 @@ public:
         return entry.busWait(address, size, write, entry.ctx);
     }
 
+    /// @brief Determines if bus wait states at the given address are reported by a device handler.
+    ///
+    /// Addresses without a handler never wait.
+    ///
+    /// @param[in] address the address to check
+    /// @return `true` if `IsBusWait` invokes a handler for this address
+    FLATTEN FORCE_INLINE bool HasBusWaitHandler(uint32 address) const {
+        const MemoryPage &entry = m_pages[(address & kAddressMask) >> pageGranularityBits];
+        return entry.array == nullptr && entry.busWaitHandled;
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // Write tracking
+
+    /// @brief Sets the function invoked when a `Write` or `Poke` modifies a tracked array-backed page.
+    ///
+    /// The callback receives the bus address and the size of the write. Pass `nullptr` to restore the default no-op.
+    ///
+    /// @param[in] fn the callback function
+    /// @param[in] context a user pointer passed as the context pointer to the callback
+    void SetArrayWriteCallback(FnArrayWrite fn, void *context) {
+        m_arrayWriteFn = fn != nullptr ? fn : [](uint32, uint32, void *) {};
+        m_arrayWriteCtx = context;
+    }
+
+    /// @brief Retrieves a pointer to the array mapped at the specified address.
+    /// @param[in] address the address to check
+    /// @return a pointer to the array byte mapped at `address`, or `nullptr` if the address is not backed by an array
+    [[nodiscard]] const uint8 *GetArrayPointer(uint32 address) const {
+        address &= kAddressMask;
+        const MemoryPage &entry = m_pages[address >> pageGranularityBits];
+        return entry.array != nullptr ? &entry.array[address & kPageMask] : nullptr;
+    }
+
+    /// @brief Enables write notifications on the array-backed page containing the specified address and on every
+    /// mirror of that page.
+    ///
+    /// `fn(mirrorAddress)` is invoked for each page mapping the same memory as `address`, with the page offset of
+    /// `address` preserved. Does nothing if the address is not backed by an array.
+    ///
+    /// @tparam Fn the type of the mirror callback
+    /// @param[in] address the address to track
+    /// @param[in] fn the mirror callback
+    template <typename Fn>
+    void TrackArrayWrites(uint32 address, Fn &&fn) {
+        address &= kAddressMask;
+        const uint8 *array = m_pages[address >> pageGranularityBits].array;
+        if (array == nullptr) {
+            return;
+        }
+        for (uint32 i = 0; i < kPageCount; i++) {
+            if (m_pages[i].array == array) {
+                m_pages[i].writeTracked = true;
+                m_fastWrite[i] = nullptr;
+                fn((i << pageGranularityBits) | (address & kPageMask));
+            }
+        }
+    }
+
+    /// @brief Disables write notifications on all pages.
+    void UntrackArrayWrites() {
+        for (uint32 i = 0; i < kPageCount; i++) {
+            m_pages[i].writeTracked = false;
+            m_fastWrite[i] = m_pages[i].arrayWritable ? m_pages[i].array : nullptr;
+        }
+    }
+
     // -----------------------------------------------------------------------------------------------------------------
     // Timing
 
@@ -334,6 +434,7 @@ private:
 
         uint8 *array = nullptr;
         bool arrayWritable = false;
+        bool writeTracked = false;
 
         // Slow path for MMIO and other regions
 
@@ -356,6 +457,7 @@ private:
         FnWrite32 poke32 = [](uint32, uint32, void *) {};
 
         FnBusWait busWait = [](uint32, uint32, bool, void *) -> bool { return false; };
+        bool busWaitHandled = false; // Whether busWait was replaced by a device handler
 
         uint64 readCycles8 = 1;
         uint64 readCycles16 = 1;
@@ -368,6 +470,14 @@ private:
 
     std::array<MemoryPage, kPageCount> m_pages;
 
+    // Fastmem tables: host pointers to array-backed pages, indexed like m_pages and checked before the page handlers.
+    // Pages with write tracking enabled are left out of the write table so that writes notify the tracking callback.
+    std::array<uint8 *, kPageCount> m_fastRead{};
+    std::array<uint8 *, kPageCount> m_fastWrite{};
+
+    FnArrayWrite m_arrayWriteFn = [](uint32, uint32, void *) {};
+    void *m_arrayWriteCtx = nullptr;
+
     template <bool normal, bool sideEffectFree, bus_handler_fn... THandlers>
         requires util::unique_types<THandlers...>
     void Map(uint32 start, uint32 end, void *context, THandlers &&...handlers) {
@@ -376,6 +486,9 @@ private:
         for (uint32 i = startIndex; i <= endIndex; i++) {
             m_pages[i].array = nullptr;
             m_pages[i].arrayWritable = false;
+            m_pages[i].writeTracked = false;
+            m_fastRead[i] = nullptr;
+            m_fastWrite[i] = nullptr;
 
             m_pages[i].ctx = context;
             if constexpr (normal) {
@@ -391,6 +504,7 @@ private:
     static void AssignHandler(MemoryPage &page, THandler &&handler) {
         if constexpr (fninfo::IsAssignable<FnBusWait, THandler>) {
             page.busWait = handler;
+            page.busWaitHandled = true;
         } else if constexpr (peekpoke) {
             if constexpr (fninfo::IsAssignable<FnRead8, THandler>) {
                 page.peek8 = handler;
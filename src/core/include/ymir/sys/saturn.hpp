@@ -13,6 +13,7 @@ See @ref index for instructions on how to use the emulator.
 #include <ymir/core/scheduler.hpp>
 
 #include <ymir/savestate/savestate.hpp>
+#include <ymir/savestate/savestate_digest.hpp>
 
 #include <ymir/debug/debug_break.hpp>
 
@@ -134,6 +135,12 @@ struct Saturn {
         return SCU.GetCartridge();
     }
 
+    /// @brief Determines if the CD block is emulated at a low level.
+    /// @return `true` if low-level CD block emulation is in use
+    [[nodiscard]] bool IsCDBlockLLE() const {
+        return m_cdblockLLE;
+    }
+
     /// @brief Loads a disc into the CD drive.
     /// @param[in] disc the disc to be moved
     void LoadDisc(media::Disc &&disc);
@@ -208,7 +215,24 @@ struct Saturn {
     /// The implementation of the function depends on the following parameters:
     /// - **Debug tracing**: configured with `EnableDebugTracing(bool)`
     /// - **SH-2 cache emulation**: configured with `EnableSH2CacheEmulation(bool)`
-    void RunFrame() {
+    ///
+    /// Shadow frames advance the entire emulated state exactly as normal frames do (including the VDP1 framebuffer),
+    /// but skip VDP2 composition, frame delivery and audio sample output. They are meant for runahead and
+    /// fast-forward, where the output of intermediate frames is discarded anyway.
+    /// @param[in] shadow whether to run a shadow frame
+    void RunFrame(bool shadow = false) {
+        RunFrame(shadow, shadow);
+    }
+
+    /// @brief Runs the emulator until the end of the current frame, selectively skipping video and audio output.
+    ///
+    /// Emulated state advances identically regardless of the flags. `RunFrame(true)` is equivalent to
+    /// `RunFrame(true, true)`.
+    /// @param[in] skipVideo whether to skip VDP2 composition and frame delivery
+    /// @param[in] skipAudio whether to skip delivery of audio samples
+    void RunFrame(bool skipVideo, bool skipAudio) {
+        VDP.SetShadowFrame(skipVideo);
+        SCSP.SetSampleOutputEnabled(!skipAudio);
         (this->*m_runFrameFn)();
     }
 
@@ -269,6 +293,14 @@ struct Saturn {
     /// @return `true` if the state was loaded successfully
     [[nodiscard]] bool LoadState(const savestate::SaveState &state, bool skipROMChecks = false);
 
+    /// @brief Computes XXH3 digests of the complete system state, one per component.
+    ///
+    /// The digests cover everything stored by `SaveState()` except the disc hash. The emulator must not be running on
+    /// another thread while this is called.
+    ///
+    /// @return the state digest
+    [[nodiscard]] savestate::StateDigest CalcStateDigest() const;
+
     // -------------------------------------------------------------------------
     // Debugger
 
@@ -387,6 +419,24 @@ private:
     /// @param[in] enabled whether to enable SH-2 cache emulation
     void UpdateSH2CacheEmulation(bool enabled);
 
+    /// @brief Enables or disables the SH-2 pre-decoded instruction cache.
+    /// @param[in] enabled whether to use the decode cache
+    void UpdateSH2DecodeCache(bool enabled);
+
+    /// @brief Enables or disables the adaptive SH-2 synchronization interval based on the configuration and the current
+    /// game's requirements.
+    void UpdateSH2SyncMode();
+
+    /// @brief Runs the master SH-2 on this thread and the slave SH-2 on the speculative runner's worker thread.
+    ///
+    /// Falls back to running the slave SH-2 after the master SH-2 if the window is rolled back.
+    ///
+    /// @param[in] targetCycles the cycle target of the window
+    /// @param[in] execCycles the cycles already executed by the master SH-2
+    /// @param[in,out] slaveCycles the cycles already executed by the slave SH-2
+    /// @return the cycles executed by the master SH-2
+    uint64 AdvanceSH2sInParallel(uint64 targetCycles, uint64 execCycles, uint64 &slaveCycles);
+
     /// @brief Updates the SH-2 overclock factor and updates system clock ratios.
     /// @param[in] factor the new overclock percentage
     void UpdateSH2OverclockFactor(uint32 factor);
@@ -400,6 +450,12 @@ private:
     /// @param[in] enabled whether to enable low-level CD block emulation
     void SetCDBlockLLE(bool enabled);
 
+    /// @brief Whether to adapt the SH-2 synchronization interval to CPU interactions, as configured.
+    bool m_adaptiveSH2Sync = true;
+
+    /// @brief Whether the current game requires strict SH-2 synchronization.
+    bool m_strictSH2Sync = false;
+
     /// @brief Whether to force SH-2 cache emulation.
     bool m_forceSH2CacheEmulation = false;
 
@@ -446,6 +502,9 @@ public:
     cdblock::YGR YGR;                          ///< CD block YGR LSI
     std::array<uint8, 512 * 1024> CDBlockDRAM; ///< CD block DRAM
 
+    sh2::DecodeCache SH2DecodeCache; ///< Pre-decoded instruction cache shared by both SH-2s
+    sh2::SyncMonitor SH2SyncMonitor; ///< Detector of master/slave SH-2 interactions
+
 private:
     // -------------------------------------------------------------------------
     // Internal state
@@ -456,9 +515,16 @@ private:
 
     uint64 m_msh2SpilloverCycles; ///< Master SH-2 execution cycles spilled over between executions
     uint64 m_ssh2SpilloverCycles; ///< Slave SH-2 execution cycles spilled over between executions
+    uint64 m_sh2SyncStep;         ///< Current master/slave SH-2 synchronization interval
     uint64 m_sh1SpilloverCycles;  ///< SH-1 execution cycles spilled over between executions
     uint64 m_sh1FracCycles;       ///< SH-1 fractional execution cycles spilled over by clock ratio calculation
 
+    sh2::SpeculativeRunner m_sh2Runner; ///< Runs the slave SH-2 on a separate thread
+
+    /// @brief Scratch state used by `CalcStateDigest()`. Allocated on first use and kept zero-initialized so that
+    /// padding bytes never affect the digest.
+    mutable std::unique_ptr<savestate::SaveState> m_digestState;
+
     // -------------------------------------------------------------------------
     // System operations (SMPC) - smpc::ISMPCOperations implementation
 
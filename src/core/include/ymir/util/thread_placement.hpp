@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+@file
+@brief Defines CPU affinity and scheduling controls for the emulator threads.
+
+Threads announce their role with a `util::ScopedThreadPlacement` for as long as they run. The placement configured for
+each role is applied when a thread registers and again whenever the configuration changes. Unregistering a thread
+restores the affinity and scheduling it had before.
+
+Placement is only applied on Linux. Elsewhere the configuration is recorded but threads run where the OS puts them.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace util {
+
+/// @brief The emulator threads that can be placed individually.
+enum class ThreadRole : uint8_t {
+    Emulation,      ///< The thread running the emulator frames
+    VDP1Render,     ///< The VDP1 render thread
+    VDP2Render,     ///< The VDP2 render thread
+    VDPDeinterlace, ///< The VDP2 deinterlace render thread
+    SCSP,           ///< The SCSP audio thread
+    SH2Speculation, ///< The slave SH-2 speculation thread
+    PoolWorker,     ///< Helper threads of `util::ThreadPool`
+};
+
+/// @brief The number of thread roles.
+inline constexpr size_t kThreadRoleCount = static_cast<size_t>(ThreadRole::PoolWorker) + 1;
+
+/// @brief Where and how threads of one role run. Unset fields leave the thread as it was when it registered.
+struct ThreadPlacement {
+    std::optional<uint64_t> affinity;    ///< Logical CPUs the thread may run on; bit N is CPU N
+    std::optional<int> nice;             ///< Nice value, from -20 (highest priority) to 19
+    std::optional<int> realtimePriority; ///< SCHED_FIFO priority from 1 to 99
+
+    /// @brief Replaces the fields set in `other`.
+    /// @param[in] other the placement to merge into this one
+    void Merge(const ThreadPlacement &other) {
+        if (other.affinity) {
+            affinity = other.affinity;
+        }
+        if (other.nice) {
+            nice = other.nice;
+        }
+        if (other.realtimePriority) {
+            realtimePriority = other.realtimePriority;
+        }
+    }
+};
+
+/// @brief A placement for every thread role, indexed by `ThreadRole`.
+using ThreadPlacements = std::array<ThreadPlacement, kThreadRoleCount>;
+
+/// @brief A physical CPU core.
+struct CPUCore {
+    uint64_t cpus;     ///< Logical CPUs of the core; bit N is CPU N
+    uint32_t capacity; ///< Relative performance of the core; higher is faster, zero if unknown
+};
+
+/// @brief Registers the current thread under a role for the lifetime of this object.
+class ScopedThreadPlacement {
+public:
+    /// @brief Registers the current thread and applies the placement configured for its role.
+    /// @param[in] role the role of the current thread
+    explicit ScopedThreadPlacement(ThreadRole role);
+
+    /// @brief Restores the thread's original placement and unregisters it.
+    ~ScopedThreadPlacement();
+
+    ScopedThreadPlacement(const ScopedThreadPlacement &) = delete;
+    ScopedThreadPlacement &operator=(const ScopedThreadPlacement &) = delete;
+
+private:
+    uint64_t m_id;
+};
+
+/// @brief Configures the placement of every thread role and applies it to all registered threads.
+/// @param[in] placements the placement of each role
+/// @param[in] automatic whether to fill in unset affinities with `ComputeAutomaticAffinities` for the host CPU
+void ConfigureThreadPlacement(const ThreadPlacements &placements, bool automatic);
+
+/// @brief Determines whether the configured placement could be fully applied the last time a thread registered or the
+/// configuration changed. Raising priorities usually requires `CAP_SYS_NICE` or suitable resource limits.
+/// @return `false` if any part of the placement was rejected by the OS
+bool IsThreadPlacementApplied();
+
+/// @brief Retrieves the physical cores this process may run on, fastest first.
+/// @return the cores, or an empty list if the topology is unknown
+std::vector<CPUCore> GetCPUCores();
+
+/// @brief Spreads the emulator threads across physical cores.
+///
+/// The emulation thread gets the fastest core to itself. The VDP2, VDP1, SCSP, SH-2 speculation and deinterlace
+/// threads get one core each from the remaining ones in that order, sharing cores only when there are not enough.
+/// Thread pool helpers may run on any core but the emulation thread's.
+///
+/// @param[in] cores the cores to place threads on, fastest first
+/// @return the affinity of each role, or unset affinities if there are fewer than two cores
+ThreadPlacements ComputeAutomaticAffinities(std::span<const CPUCore> cores);
+
+/// @brief Parses per-role placements.
+///
+/// The specification is a `;`-separated list of `role:key=value:...` entries. Roles are `main`, `vdp1`, `vdp2`,
+/// `deinterlace`, `scsp`, `sh2` and `worker`. Keys are `cpus` (a list of CPUs and ranges such as `2-3,6`), `nice` and
+/// `fifo` (the SCHED_FIFO priority). For example: `vdp2:cpus=2-3:nice=-5;scsp:cpus=4:fifo=20`.
+///
+/// @param[in] spec the placement specification
+/// @return the placement of each role, or `std::nullopt` if the specification is malformed
+std::optional<ThreadPlacements> ParseThreadPlacements(std::string_view spec);
+
+} // namespace util
@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+@file
+@brief Defines `util::ThreadPool`, the process-wide budget of threads shared by every emulator instance.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/// @brief A pool of threads that caps how many emulator threads run at once.
+///
+/// The pool hands out two kinds of threads against a single thread budget:
+/// - Dedicated threads run one long-lived loop each, such as the VDP render threads or the SCSP thread. They block on
+///   their own events, so they cannot be multiplexed onto shared workers, but they count against the budget while they
+///   run.
+/// - Batches of short parallel tasks submitted through `ParallelFor` borrow helper workers from whatever is left of the
+///   budget after the calling thread and the running dedicated threads. The caller always takes part, so a batch still
+///   completes with no helpers at all.
+///
+/// Batches are split into one contiguous range per participant. Each participant drains its own range first and then
+/// steals from the others, so uneven tasks still keep every participant busy until the end.
+///
+/// Use `Shared()` to get the pool shared by every emulator instance in the process. This keeps several instances from
+/// each spawning a full set of helpers and oversubscribing the host.
+class ThreadPool {
+public:
+    /// @brief Creates a pool with the given thread budget.
+    /// @param[in] threadBudget the maximum number of threads to run at once, including the threads that submit batches
+    /// and the dedicated threads. Zero picks `DefaultThreadBudget()`.
+    explicit ThreadPool(size_t threadBudget = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /// @brief Retrieves the pool shared by every emulator instance in the process.
+    static ThreadPool &Shared();
+
+    /// @brief Picks a thread budget that fills the host without oversubscribing it.
+    static size_t DefaultThreadBudget();
+
+    /// @brief Changes the thread budget. Batches already running keep the helpers they started with.
+    /// @param[in] threadBudget the new thread budget. Zero picks `DefaultThreadBudget()`.
+    void SetThreadBudget(size_t threadBudget);
+
+    /// @brief Retrieves the current thread budget.
+    [[nodiscard]] size_t GetThreadBudget() const {
+        return m_threadBudget.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Retrieves the number of dedicated threads currently running.
+    [[nodiscard]] size_t GetDedicatedThreadCount() const {
+        return m_dedicatedThreads.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Retrieves the number of helpers a batch submitted now could use.
+    [[nodiscard]] size_t GetAvailableHelperCount() const;
+
+    /// @brief Starts a dedicated thread that counts against the thread budget until `fn` returns.
+    /// @tparam Fn the type of the thread function
+    /// @param[in] fn the function to run on the new thread
+    /// @return the new thread, to be joined by the caller
+    template <typename Fn>
+    [[nodiscard]] std::thread StartDedicated(Fn &&fn) {
+        m_dedicatedThreads.fetch_add(1, std::memory_order_relaxed);
+        return std::thread{[this, fn = std::forward<Fn>(fn)]() mutable {
+            fn();
+            m_dedicatedThreads.fetch_sub(1, std::memory_order_relaxed);
+        }};
+    }
+
+    /// @brief Runs `task(i)` for every `i` in `[0, count)` and waits for all of them to finish.
+    ///
+    /// Batches submitted while another batch is running, including from within a task, run inline on the calling
+    /// thread.
+    ///
+    /// @param[in] count the number of tasks
+    /// @param[in] task the function invoked with each task index; must be safe to call concurrently
+    void ParallelFor(size_t count, const std::function<void(size_t)> &task);
+
+private:
+    /// @brief A contiguous range of task indices owned by one participant of a batch.
+    struct alignas(64) Range {
+        std::atomic<size_t> next;
+        size_t end;
+    };
+
+    void WorkerLoop();
+    void RunRanges(size_t participant);
+
+    std::atomic<size_t> m_threadBudget;
+    std::atomic<size_t> m_dedicatedThreads = 0;
+
+    std::atomic<bool> m_batchRunning = false;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCond;
+    std::condition_variable m_doneCond;
+    uint64_t m_generation = 0;
+    size_t m_openSlots = 0;
+    size_t m_nextSlot = 0;
+    size_t m_activeHelpers = 0;
+    bool m_quit = false;
+
+    // Current batch, published under m_mutex
+    const std::function<void(size_t)> *m_task = nullptr;
+    std::unique_ptr<Range[]> m_ranges;
+    size_t m_rangeCapacity = 0;
+    size_t m_rangeCount = 0;
+};
+
+} // namespace util
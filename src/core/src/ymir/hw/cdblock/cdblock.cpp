@@ -135,11 +135,23 @@ void CDBlock::Reset(bool hard) {
     m_xferBuffer.fill(0xFFFF);
     m_xferBufferPos = 0;
 
+    m_xferSectorPos = 0;
+    m_xferSectorEnd = 0;
+    m_xferPartition = 0;
+    m_xferGetLength = 0;
+    m_xferDelStart = 0;
+    m_xferDelCount = 0;
+
     m_xferSubcodeFrameAddress = 0;
     m_xferSubcodeGroup = 0;
 
+    m_xferExtraCount = 0;
+
     m_partitionManager.Reset();
 
+    m_scratchBuffers.fill({});
+    m_scratchBufferPutIndex = 0;
+
     for (auto &filter : m_filters) {
         filter.Reset();
     }
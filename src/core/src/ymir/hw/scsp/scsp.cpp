@@ -2,8 +2,9 @@
 
 #include <ymir/sys/clocks.hpp>
 
-#include <ymir/util/scope_guard.hpp>
 #include <ymir/util/thread_name.hpp>
+#include <ymir/util/thread_placement.hpp>
+#include <ymir/util/thread_pool.hpp>
 
 #include <algorithm>
 #include <limits>
@@ -44,7 +45,8 @@ SCSP::SCSP(core::Scheduler &scheduler, core::Configuration::Audio &config)
 
     // Replicate interpolation mode to avoid an extra dereference in the hot path
     config.interpolation.Observe(m_interpMode);
-    config.threadedSCSP.Observe([&](bool value) { EnableThreading(value); });
+    config.m68kIdleSkip.Observe(m_m68kIdleSkip);
+    config.specializeDSP.Observe(m_dsp.specializeProgram);
 
     m_sampleTickEvent =
         m_scheduler.RegisterEvent(core::events::SCSPSample, this,
@@ -54,6 +56,8 @@ SCSP::SCSP(core::Scheduler &scheduler, core::Configuration::Audio &config)
         m_slots[i].index = i;
     }
 
+    config.threadedSCSP.ObserveAndNotify([&](bool value) { EnableThreading(value); });
+
     Reset(true);
 }
 
@@ -73,6 +77,7 @@ void SCSP::Reset(bool hard) {
     m_midiInputWritePos = 0;
     m_midiInputOverflow = false;
 
+    m_midiOutputBuffer.fill(0);
     m_midiOutputSize = 0;
     m_expectedOutputPacketSize = 0;
 
@@ -86,6 +91,7 @@ void SCSP::Reset(bool hard) {
     m_m68k.Reset(true);
     m_m68kSpilloverCycles = 0;
     m_m68kEnabled = false;
+    m_m68kIdleLoop.Reset();
 
     m_m68kCycles = 0;
     m_sampleCounter = 0;
@@ -140,14 +146,22 @@ void SCSP::Reset(bool hard) {
     while (m_threadEventQueue.try_dequeue(m_ctokThreadEventQueue, dummy)) {
     }
 
-    m_scspInterruptLevel = false;
-    m_lastSCSPInterruptLevel = false;
+    m_soundRequestLevel = false;
+    m_threadSoundRequestLevel = false;
+    m_soundRequestToggles.fill(0);
+    m_sampleEvents.fill(m_eventsEnqueued);
+    {
+        std::lock_guard lock{m_soundRequestMutex};
+        m_soundRequestChanges.clear();
+        m_soundRequestChanged = false;
+    }
 }
 
 void SCSP::MapMemoryDirect(sys::SH2Bus &bus) {
     bus.MapArray(0x5A0'0000, 0x5A7'FFFF, m_WRAM, true);
 }
 
+// Sound RAM accesses go through handlers that sync with the SCSP thread, so they skip the bus fastmem tables
 void SCSP::MapMemoryThreaded(sys::SH2Bus &bus) {
     static constexpr auto cast = [](void *ctx) -> SCSP & { return *static_cast<SCSP *>(ctx); };
 
@@ -240,14 +254,8 @@ void SCSP::SetDebugTracing(bool enable) {
 }
 
 uint32 SCSP::ReceiveCDDA(std::span<uint8, 2352> data) {
-    if (m_threadedSCSP) {
-        m_cddaMutex.lock();
-    }
-    util::ScopeGuard sgUnlock{[&] {
-        if (m_threadedSCSP) {
-            m_cddaMutex.unlock();
-        }
-    }};
+    // Catch up so that the buffer level reported back is the same as when running on a single thread
+    SyncSCSPThread();
 
     std::copy_n(data.begin(), 2352, m_cddaBuffer.begin() + m_cddaWritePos);
     m_cddaWritePos = (m_cddaWritePos + 2352) % m_cddaBuffer.size();
@@ -262,14 +270,7 @@ uint32 SCSP::ReceiveCDDA(std::span<uint8, 2352> data) {
 }
 
 void SCSP::ReceiveMidiInput(MidiMessage &msg) {
-    if (m_threadedSCSP) {
-        m_midiQueueMutex.lock();
-    }
-    util::ScopeGuard sgUnlock{[&] {
-        if (m_threadedSCSP) {
-            m_midiQueueMutex.unlock();
-        }
-    }};
+    SyncSCSPThread();
 
     // if we reset, and this is the first message received, ignore delta time & play now
     if (m_nextMidiTime != 0) {
@@ -293,17 +294,7 @@ void SCSP::ReceiveMidiInput(MidiMessage &msg) {
     m_midiInputQueue.push(QueuedMidiMessage(m_nextMidiTime, std::move(msg.payload)));
 }
 
-template <bool threaded>
 void SCSP::ProcessMidiInputQueue() {
-    if constexpr (threaded) {
-        m_midiQueueMutex.lock();
-    }
-    util::ScopeGuard sgUnlock{[&] {
-        if constexpr (threaded) {
-            m_midiQueueMutex.unlock();
-        }
-    }};
-
     // TODO: I believe MIDI stuff is *supposed* to trigger interrupts...
     // however there are no commercial games relying on this behavior, so it should be fine for now.
 
@@ -407,18 +398,21 @@ void SCSP::DumpDSPRegs(std::ostream &out) const {
 }
 
 void SCSP::SetCPUEnabled(bool enabled) {
+    SyncSCSPThread();
     if (m_m68kEnabled != enabled) {
         devlog::info<grp::base>("MC68EC00 processor {}", (enabled ? "enabled" : "disabled"));
         if (enabled) {
             m_m68k.Reset(true); // false? does it matter?
             m_m68kSpilloverCycles = 0;
         }
+        m_m68kIdleLoop.Reset();
         m_m68kEnabled = enabled;
     }
 }
 
 void SCSP::SaveState(savestate::SCSPSaveState &state) const {
     const_cast<SCSP *>(this)->SyncSCSPThread();
+    const_cast<SCSP *>(this)->CollectSoundRequestChanges();
     state.WRAM = m_WRAM;
     state.cddaBuffer = m_cddaBuffer;
     state.cddaReadPos = m_cddaReadPos;
@@ -428,6 +422,16 @@ void SCSP::SaveState(savestate::SCSPSaveState &state) const {
     m_m68k.SaveState(state.m68k);
     state.m68kSpilloverCycles = m_m68kSpilloverCycles;
     state.m68kEnabled = m_m68kEnabled;
+    state.m68kIdleLoop.state = static_cast<uint8>(m_m68kIdleLoop.state);
+    state.m68kIdleLoop.disqualified = m_m68kIdleLoop.disqualified;
+    state.m68kIdleLoop.loopPC = m_m68kIdleLoop.loopPC;
+    state.m68kIdleLoop.cpuState = m_m68kIdleLoop.cpuState;
+    state.m68kIdleLoop.watches.fill({});
+    for (size_t i = 0; i < m_m68kIdleLoop.numWatches; i++) {
+        const M68KIdleLoopWatch &watch = m_m68kIdleLoop.watches[i];
+        state.m68kIdleLoop.watches[i] = {watch.address, watch.value, watch.size};
+    }
+    state.m68kIdleLoop.numWatches = m_m68kIdleLoop.numWatches;
 
     for (size_t i = 0; i < 32; i++) {
         m_slots[i].SaveState(state.slots[i]);
@@ -450,6 +454,8 @@ void SCSP::SaveState(savestate::SCSPSaveState &state) const {
     state.SCIEB = m_m68kEnabledInterrupts;
     state.SCIPD = m_m68kPendingInterrupts;
     state.SCILV = m_m68kInterruptLevels;
+    state.soundRequestLevel = m_soundRequestLevel;
+    state.soundRequestToggles = m_soundRequestToggles;
     state.reuseSCILV = false;
 
     state.DEXE = m_dmaExec;
@@ -538,6 +544,21 @@ void SCSP::LoadState(const savestate::SCSPSaveState &state) {
     m_m68k.LoadState(state.m68k);
     m_m68kSpilloverCycles = state.m68kSpilloverCycles;
     m_m68kEnabled = state.m68kEnabled;
+    switch (state.m68kIdleLoop.state) {
+    case static_cast<uint8>(M68KIdleLoopState::Monitoring):
+        m_m68kIdleLoop.state = M68KIdleLoopState::Monitoring;
+        break;
+    case static_cast<uint8>(M68KIdleLoopState::Idle): m_m68kIdleLoop.state = M68KIdleLoopState::Idle; break;
+    default: m_m68kIdleLoop.state = M68KIdleLoopState::Searching; break;
+    }
+    m_m68kIdleLoop.disqualified = state.m68kIdleLoop.disqualified;
+    m_m68kIdleLoop.loopPC = state.m68kIdleLoop.loopPC;
+    m_m68kIdleLoop.cpuState = state.m68kIdleLoop.cpuState;
+    for (size_t i = 0; i < kM68KMaxIdleLoopWatches; i++) {
+        const auto &watch = state.m68kIdleLoop.watches[i];
+        m_m68kIdleLoop.watches[i] = {watch.address, watch.value, watch.size};
+    }
+    m_m68kIdleLoop.numWatches = std::min<uint32>(state.m68kIdleLoop.numWatches, kM68KMaxIdleLoopWatches);
 
     for (size_t i = 0; i < 32; i++) {
         m_slots[i].LoadState(state.slots[i]);
@@ -598,8 +619,26 @@ void SCSP::LoadState(const savestate::SCSPSaveState &state) {
     while (m_threadEventQueue.try_dequeue(m_ctokThreadEventQueue, dummy)) {
     }
 
-    m_scspInterruptLevel = (m_scuPendingInterrupts & m_scuEnabledInterrupts) != 0;
-    m_lastSCSPInterruptLevel = m_scspInterruptLevel;
+    // Changes still in flight on a threaded SCSP are delivered on the same sample ticks as they would have been.
+    // Without the thread, the SCU gets the level they lead to with the next change instead.
+    uint32 toggles = 0;
+    for (uint16 count : state.soundRequestToggles) {
+        toggles += count;
+    }
+    {
+        std::lock_guard lock{m_soundRequestMutex};
+        m_soundRequestChanges.clear();
+        m_soundRequestChanged = false;
+    }
+    m_sampleEvents.fill(m_eventsEnqueued);
+    if (m_threadedSCSP) {
+        m_soundRequestLevel = state.soundRequestLevel;
+        m_soundRequestToggles = state.soundRequestToggles;
+        m_threadSoundRequestLevel = m_soundRequestLevel ^ (toggles & 1u);
+    } else {
+        m_soundRequestLevel = state.soundRequestLevel ^ (toggles & 1u);
+        m_soundRequestToggles.fill(0);
+    }
 
     // Realign the tick event if the save state was using a more granular slot step
     if (m_stepGranularity <= 5u && (m_currSlot & ((1u << m_stepGranularity) - 1u)) != 0) {
@@ -624,7 +663,7 @@ void SCSP::OnSampleTickEvent(core::EventContext &eventContext, void *userContext
     if constexpr (threaded) {
         scsp.TickSampleThreaded();
     } else {
-        scsp.TickSample<debug, false>();
+        scsp.TickSample<debug>();
     }
     eventContext.Reschedule(kCyclesPerSample);
 }
@@ -638,14 +677,14 @@ void SCSP::OnTransitionalTickEvent(core::EventContext &eventContext, void *userC
     // Check if the slot counter is aligned
     auto &scsp = *static_cast<SCSP *>(userContext);
     if ((scsp.m_currSlot & kSlotIndexMask) == 0) {
-        // Aligned; switch to the bigger tick event
+        // Aligned; switch to the bigger tick event and process this step with it
         if constexpr (newStepShift == 5u) {
             scsp.m_scheduler.SetEventCallback(scsp.m_sampleTickEvent, &scsp, OnSampleTickEvent<debug, threaded>);
-            eventContext.Reschedule(kCyclesPerSample);
+            OnSampleTickEvent<debug, threaded>(eventContext, userContext);
         } else {
             scsp.m_scheduler.SetEventCallback(scsp.m_sampleTickEvent, &scsp,
                                               OnSlotTickEvent<newStepShift, debug, threaded>);
-            eventContext.Reschedule(kCyclesPerSlot << newStepShift);
+            OnSlotTickEvent<newStepShift, debug, threaded>(eventContext, userContext);
         }
     } else {
         // Not yet aligned; continue ticking slots one by one
@@ -747,12 +786,17 @@ void SCSP::EnableThreading(bool enable) {
             MapMemoryThreaded(*m_bus);
         }
 
+        m_threadSoundRequestLevel = m_soundRequestLevel;
+        m_sampleEvents.fill(m_eventsEnqueued);
+
         m_threadRunning = true;
-        m_scspThread = std::thread{[this] { SCSPThreadLoop(); }};
+        m_scspThread = util::ThreadPool::Shared().StartDedicated([this] { SCSPThreadLoop(); });
     } else {
         devlog::debug<grp::base>("Disabling threaded SCSP");
 
         StopSCSPThread();
+        CollectSoundRequestChanges();
+        FlushSoundRequests();
 
         if (m_bus) {
             MapMemoryDirect(*m_bus);
@@ -881,39 +925,106 @@ void SCSP::ExecuteDMA() {
 template <uint32 stepShift, bool debug>
 FORCE_INLINE void SCSP::TickSlots() {
     RunM68K(kM68KCyclesPerSlot << stepShift);
-    ProcessMidiInputQueue<false>();
+    ProcessMidiInputQueue();
     StepSlots<stepShift, false>();
 }
 
-template <bool debug, bool threaded>
+template <bool debug>
 FORCE_INLINE void SCSP::TickSample() {
     RunM68K(kM68KCyclesPerSample);
-    ProcessMidiInputQueue<threaded>();
-    StepSample<debug, threaded>();
+    ProcessMidiInputQueue();
+    StepSample<debug>();
 }
 
 FORCE_INLINE void SCSP::RunM68K(uint64 cycles) {
     if (m_m68kEnabled) {
+        if (m_m68kIdleLoop.state == M68KIdleLoopState::Idle) {
+            if (!M68KIdleLoopShouldWake()) {
+                // The CPU would just spin in the idle loop; the leftover cycles carry over unchanged
+                return;
+            }
+            m_m68kIdleLoop.state = M68KIdleLoopState::Searching;
+        }
+
         cycles <<= m_m68kClockShift;
         uint64 cy = m_m68kSpilloverCycles;
-        while (cy < cycles) {
-            cy += m_m68k.Step();
+        if (m_m68kIdleSkip) {
+            while (cy < cycles) {
+                const uint32 prevPC = m_m68k.GetPC();
+                cy += m_m68k.Step();
+                M68KIdleLoopCheck(prevPC);
+                if (m_m68kIdleLoop.state == M68KIdleLoopState::Idle) {
+                    // The rest of the time slice would be spent spinning in the loop
+                    break;
+                }
+            }
+        } else {
+            while (cy < cycles) {
+                cy += m_m68k.Step();
+            }
+        }
+        m_m68kSpilloverCycles = cy > cycles ? cy - cycles : 0;
+    }
+}
+
+void SCSP::M68KIdleLoopCheck(uint32 prevPC) {
+    const uint32 pc = m_m68k.GetPC();
+    // Branches to self leave the prefetch address unchanged
+    if (pc > prevPC || prevPC - pc > kM68KMaxIdleLoopSize) [[likely]] {
+        return;
+    }
+
+    auto &loop = m_m68kIdleLoop;
+    if (loop.state == M68KIdleLoopState::Monitoring && loop.loopPC == pc) {
+        if (!loop.disqualified) {
+            savestate::M68KSaveState cpuState{};
+            m_m68k.SaveState(cpuState);
+            const savestate::M68KSaveState &prev = loop.cpuState;
+            if (cpuState.DA == prev.DA && cpuState.SP_swap == prev.SP_swap && cpuState.PC == prev.PC &&
+                cpuState.SR == prev.SR && cpuState.prefetchQueue == prev.prefetchQueue) {
+                // A full iteration went by without changing anything; the loop is waiting for something external
+                loop.state = M68KIdleLoopState::Idle;
+                return;
+            }
         }
-        m_m68kSpilloverCycles = cy - cycles;
     }
+
+    // Start monitoring a new loop or another iteration of the same loop
+    loop.state = M68KIdleLoopState::Monitoring;
+    loop.disqualified = false;
+    loop.loopPC = pc;
+    loop.cpuState = {};
+    m_m68k.SaveState(loop.cpuState);
+    loop.numWatches = 0;
+}
+
+bool SCSP::M68KIdleLoopShouldWake() {
+    if (!m_m68kIdleSkip || m_m68k.IsInterruptPending()) {
+        return true;
+    }
+    const auto &loop = m_m68kIdleLoop;
+    for (uint32 i = 0; i < loop.numWatches; i++) {
+        const M68KIdleLoopWatch &watch = loop.watches[i];
+        const uint16 value = watch.size == sizeof(uint8) ? ReadWRAM<uint8>(watch.address)
+                                                          : ReadWRAM<uint16>(watch.address);
+        if (value != watch.value) {
+            return true;
+        }
+    }
+    return false;
 }
 
 template <uint32 stepShift, bool debug>
 FORCE_INLINE void SCSP::StepSlots() {
     if constexpr (stepShift == 5u) {
-        ProcessSlots<debug, false>(m_currSlot);
+        ProcessSlots<debug>(m_currSlot);
         ++m_currSlot;
     } else {
         static constexpr uint32 kNumSlots = 1u << stepShift;
         static constexpr uint32 kSlotMask = kNumSlots - 1u;
         assert((m_currSlot & kSlotMask) == 0);
         for (uint32 i = 0; i < kNumSlots; ++i) {
-            ProcessSlots<debug, false>(m_currSlot + i);
+            ProcessSlots<debug>(m_currSlot + i);
         }
         m_currSlot += kNumSlots;
     }
@@ -924,11 +1035,11 @@ FORCE_INLINE void SCSP::StepSlots() {
     }
 }
 
-template <bool debug, bool threaded>
+template <bool debug>
 FORCE_INLINE void SCSP::StepSample() {
     assert(m_currSlot == 0);
     for (uint32 i = 0; i < 32; ++i) {
-        ProcessSlots<debug, threaded>(i);
+        ProcessSlots<debug>(i);
     }
     IncrementSampleCounter();
 }
@@ -943,7 +1054,7 @@ FORCE_INLINE void SCSP::UpdateTimers() {
     }
 }
 
-template <bool debug, bool threaded>
+template <bool debug>
 FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
     const uint32 op1SlotIndex = i;
     const uint32 op2SlotIndex = (i - 1u) & 31;
@@ -1036,20 +1147,13 @@ FORCE_INLINE void SCSP::ProcessSlots(uint32 i) {
         }
 
         // Write to output and reset
-        m_cbOutputSample(m_out[0], m_out[1]);
+        if (m_sampleOutputEnabled) {
+            m_cbOutputSample(m_out[0], m_out[1]);
+        }
         m_out.fill(0);
 
         // Copy CDDA data to DSP EXTS (0=left, 1=right)
         {
-            if constexpr (threaded) {
-                m_cddaMutex.lock();
-            }
-            util::ScopeGuard sgUnlock{[&] {
-                if constexpr (threaded) {
-                    m_cddaMutex.unlock();
-                }
-            }};
-
             if (m_cddaReady && m_cddaReadPos != m_cddaWritePos) {
                 m_dsp.audioInOut[0] = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 0]);
                 m_dsp.audioInOut[1] = util::ReadLE<uint16>(&m_cddaBuffer[m_cddaReadPos + 2]);
@@ -1379,6 +1483,7 @@ SCSP::Probe::Probe(SCSP &scsp)
 
 void SCSP::SCSPThreadLoop() {
     util::SetCurrentThreadName("SCSP thread");
+    util::ScopedThreadPlacement placement{util::ThreadRole::SCSP};
 
     std::array<ThreadEvent, 64> events{};
 
@@ -1413,9 +1518,9 @@ void SCSP::SCSPThreadLoop() {
             case ThreadEvent::Type::Sample:
                 // Process one sample
                 if (m_debugTracing) {
-                    TickSample<true, true>();
+                    TickSample<true>();
                 } else {
-                    TickSample<false, true>();
+                    TickSample<false>();
                 }
                 break;
 
@@ -1440,24 +1545,14 @@ void SCSP::SyncSCSPThread() {
         return;
     }
 
-    uint64 target = m_eventsProcessed.load();
-    while (target != m_eventsEnqueued) {
-        m_eventsProcessed.wait(target, std::memory_order_acquire);
-        target = m_eventsProcessed.load(std::memory_order_acquire);
-    }
-
-    PollSCSPInterrupts();
+    WaitForSCSPThread(m_eventsEnqueued);
 }
 
-void SCSP::PollSCSPInterrupts() {
-    if (!m_threadedSCSP) {
-        return;
-    }
-    bool expected = m_lastSCSPInterruptLevel;
-    bool current = m_scspInterruptLevel.load(std::memory_order_relaxed);
-    if (expected != current) {
-        m_lastSCSPInterruptLevel = current;
-        m_cbTriggerSoundRequestInterrupt(current);
+void SCSP::WaitForSCSPThread(uint64 target) {
+    uint64 processed = m_eventsProcessed.load(std::memory_order_acquire);
+    while (processed < target) {
+        m_eventsProcessed.wait(processed, std::memory_order_acquire);
+        processed = m_eventsProcessed.load(std::memory_order_acquire);
     }
 }
 
@@ -1515,8 +1610,57 @@ template void SCSP::WriteRegBus<uint8>(uint32 address, uint8 value);
 template void SCSP::WriteRegBus<uint16>(uint32 address, uint16 value);
 
 void SCSP::TickSampleThreaded() {
+    // Only wait for the oldest sample in flight, which is the one whose sound request changes are due now
+    WaitForSCSPThread(m_sampleEvents[0]);
+    CollectSoundRequestChanges();
+    DeliverSoundRequests();
+
     EnqueueEvent(ThreadEvent::Sample());
-    PollSCSPInterrupts();
+    std::copy(m_sampleEvents.begin() + 1, m_sampleEvents.end(), m_sampleEvents.begin());
+    m_sampleEvents.back() = m_eventsEnqueued;
+}
+
+void SCSP::PublishSoundRequest(bool level) {
+    if (level == m_threadSoundRequestLevel) {
+        return;
+    }
+    m_threadSoundRequestLevel = level;
+
+    // Timestamp the change with the event being processed
+    std::lock_guard lock{m_soundRequestMutex};
+    m_soundRequestChanges.push_back(m_eventsProcessed.load(std::memory_order_relaxed) + 1);
+    m_soundRequestChanged.store(true, std::memory_order_relaxed);
+}
+
+void SCSP::CollectSoundRequestChanges() {
+    if (!m_soundRequestChanged.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // A change is due on the first sample tick that waits for the event that caused it. Changes made after the last
+    // queued sample are due on the tick after the ones waiting for the samples in flight.
+    std::lock_guard lock{m_soundRequestMutex};
+    for (const uint64 event : m_soundRequestChanges) {
+        const auto due = std::lower_bound(m_sampleEvents.begin(), m_sampleEvents.end(), event);
+        ++m_soundRequestToggles[due - m_sampleEvents.begin()];
+    }
+    m_soundRequestChanges.clear();
+    m_soundRequestChanged.store(false, std::memory_order_relaxed);
+}
+
+void SCSP::DeliverSoundRequests() {
+    for (uint16 i = 0; i < m_soundRequestToggles[0]; ++i) {
+        m_soundRequestLevel = !m_soundRequestLevel;
+        m_cbTriggerSoundRequestInterrupt(m_soundRequestLevel);
+    }
+    std::copy(m_soundRequestToggles.begin() + 1, m_soundRequestToggles.end(), m_soundRequestToggles.begin());
+    m_soundRequestToggles.back() = 0;
+}
+
+void SCSP::FlushSoundRequests() {
+    for (size_t i = 0; i < m_soundRequestToggles.size(); ++i) {
+        DeliverSoundRequests();
+    }
 }
 
 template <uint32 stepShift>
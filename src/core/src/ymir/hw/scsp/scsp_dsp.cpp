@@ -28,7 +28,7 @@ void DSP::Reset() {
     // 4 DSP program steps per slot -> -6*4 = -24 = 104 (or 0x68) in modulo 128
     PC = 0x68;
 
-    m_programLength = 0;
+    UpdateProgramLength();
 
     INPUTS = 0;
 
@@ -50,18 +50,15 @@ void DSP::Reset() {
     m_writeValue = 0;
 
     m_readWriteAddr = 0;
+
+    CompileProgram();
 }
 
-void DSP::UpdateProgramLength(uint8 writeIndex) {
-    const bool wroteNOP = program[writeIndex].u64 == 0;
-    if (wroteNOP && writeIndex == m_programLength - 1) {
-        // If writing a NOP to the last instruction, shrink the program
-        while (m_programLength > 0 && program[m_programLength - 1].u64 == 0) {
-            --m_programLength;
-        }
-    } else if (!wroteNOP && writeIndex >= m_programLength) {
-        // If writing anything other than a NOP past the current program length, increase program length
-        m_programLength = writeIndex + 1;
+void DSP::UpdateProgramLength() {
+    // The length depends on the program alone so that loading a save state reproduces it exactly
+    m_programLength = program.size();
+    while (m_programLength > 0 && program[m_programLength - 1].u64 == 0) {
+        --m_programLength;
     }
 
     // Run one extra NOP to ensure side-effects are carried out
@@ -137,16 +134,14 @@ bool DSP::ValidateState(const savestate::SCSPDSPSaveState &state) const {
 }
 
 void DSP::LoadState(const savestate::SCSPDSPSaveState &state) {
-    m_programLength = 0;
+    // Only recompile instructions that changed; restoring a recent state usually leaves the program untouched
     for (size_t i = 0; i < program.size(); i++) {
-        program[i].u64 = state.MPRO[i];
-        if (program[i].u64 != 0) {
-            m_programLength = i + 1;
+        if (program[i].u64 != state.MPRO[i]) {
+            program[i].u64 = state.MPRO[i];
+            CompileInstruction(static_cast<uint8>(i));
         }
     }
-    if (m_programLength < program.size()) {
-        ++m_programLength;
-    }
+    UpdateProgramLength();
 
     tempMem = state.TEMP;
     soundMem = state.MEMS;
@@ -192,4 +187,175 @@ void DSP::LoadState(const savestate::SCSPDSPSaveState &state) {
     UpdateRBL();
 }
 
+// -----------------------------------------------------------------------------
+// Program specialization
+
+template <size_t... indices>
+constexpr std::array<DSP::FnExecute, sizeof...(indices)> DSP::MakeCompiledHandlers(std::index_sequence<indices...>) {
+    // Index bits: 5-4 = inputs source, 3-2 = YSEL, 1-0 = SHFT
+    return {&DSP::ExecuteCompiled<(indices >> 4u) & 3u, (indices >> 2u) & 3u, indices & 3u>...};
+}
+
+void DSP::CompileInstruction(uint8 index) {
+    static constexpr auto kHandlers = MakeCompiledHandlers(std::make_index_sequence<4 * 4 * 4>{});
+
+    const DSPInstr instr = program[index];
+    CompiledInstr &compiled = m_compiledProgram[index];
+
+    uint32 inputsSource;
+    if (instr.IRA <= 0x1F) {
+        inputsSource = kInputsMEMS;
+        compiled.inputsAddr = instr.IRA;
+    } else if (instr.IRA <= 0x2F) {
+        inputsSource = kInputsMIXS;
+        compiled.inputsAddr = instr.IRA & 0xF;
+    } else if (instr.IRA <= 0x31) {
+        inputsSource = kInputsEXTS;
+        compiled.inputsAddr = instr.IRA & 0x1;
+    } else {
+        inputsSource = kInputsNone;
+        compiled.inputsAddr = 0;
+    }
+    compiled.fn = kHandlers[(inputsSource << 4u) | (instr.YSEL << 2u) | instr.SHFT];
+
+    compiled.TRA = instr.TRA;
+    compiled.TWA = instr.TWA;
+    compiled.CRA = instr.CRA;
+    compiled.IWA = instr.IWA;
+    compiled.EWA = instr.EWA;
+    compiled.MASA = instr.MASA;
+    compiled.NXADR = instr.NXADR;
+    compiled.adderSource = instr.ZERO ? kAdderZero : instr.BSEL ? kAdderSFT : kAdderTEMP;
+
+    compiled.XSEL = instr.XSEL;
+    compiled.YRL = instr.YRL;
+    compiled.FRCL = instr.FRCL;
+    compiled.ADRL = instr.ADRL;
+    compiled.NEGB = instr.NEGB;
+    compiled.EWT = instr.EWT;
+    compiled.TWT = instr.TWT;
+    compiled.IWT = instr.IWT;
+    compiled.MRD = instr.MRD;
+    compiled.MWT = instr.MWT;
+    compiled.NOFL = instr.NOFL;
+    compiled.ADREB = instr.ADREB;
+    compiled.TABLE = instr.TABLE;
+}
+
+void DSP::CompileProgram() {
+    for (uint32 i = 0; i < program.size(); i++) {
+        CompileInstruction(i);
+    }
+}
+
+// Mirrors Interpret() with the input source, Y input select and shifter mode resolved at compile time.
+template <uint32 inputsSource, uint32 ysel, uint32 shft>
+void DSP::ExecuteCompiled(const CompiledInstr &instr) {
+    static constexpr bool shft0 = bit::test<0>(shft);
+    static constexpr bool shft1 = bit::test<1>(shft);
+
+    if constexpr (inputsSource == kInputsMEMS) {
+        INPUTS = soundMem[instr.inputsAddr];
+    } else if constexpr (inputsSource == kInputsMIXS) {
+        INPUTS = mixStack[GetMIXSIndex(instr.inputsAddr) ^ 0x10] << 4;
+    } else if constexpr (inputsSource == kInputsEXTS) {
+        INPUTS = audioInOut[instr.inputsAddr] << 8;
+    }
+
+    const uint8 tempReadAddr = (instr.TRA + MDEC_CT) & 0x7F;
+    const uint8 tempWriteAddr = (instr.TWA + MDEC_CT) & 0x7F;
+
+    const sint32 inputs = INPUTS;
+    const sint32 temp = tempMem[tempReadAddr];
+
+    const sint32 xval = instr.XSEL ? inputs : temp;
+    uint16 yval;
+    if constexpr (ysel == 0) {
+        yval = FRC_REG;
+    } else if constexpr (ysel == 1) {
+        yval = coeffs[instr.CRA];
+    } else if constexpr (ysel == 2) {
+        yval = static_cast<uint16>(bit::extract<11, 23>(Y_REG));
+    } else {
+        yval = static_cast<uint16>(bit::extract<4, 15>(Y_REG));
+    }
+
+    if (instr.YRL) {
+        Y_REG = bit::extract<0, 23>(inputs);
+    }
+
+    sint32 shifterOut = static_cast<uint32>(bit::sign_extend<26>(SFT_REG)) << (shft0 ^ shft1);
+    if constexpr (!shft1) {
+        shifterOut = std::clamp(shifterOut, -0x800000, 0x7FFFFF);
+    } else {
+        shifterOut = bit::sign_extend<24>(shifterOut);
+    }
+
+    if (instr.FRCL) {
+        if constexpr (shft == 3) {
+            FRC_REG = bit::extract<0, 11>(shifterOut);
+        } else {
+            FRC_REG = bit::extract<11, 23>(shifterOut);
+        }
+    }
+
+    uint32 sgaOutput;
+    switch (instr.adderSource) {
+    case kAdderZero: sgaOutput = 0; break;
+    case kAdderSFT: sgaOutput = instr.NEGB ? -static_cast<sint32>(SFT_REG) : SFT_REG; break;
+    default: sgaOutput = instr.NEGB ? -temp : temp; break;
+    }
+    const uint32 product = (bit::sign_extend<13, sint64>(yval) * xval) >> 12;
+    SFT_REG = (product + sgaOutput) & 0x3FFFFFF;
+
+    if (instr.EWT) {
+        effectOut[instr.EWA] = shifterOut >> 8;
+    }
+    if (instr.TWT) {
+        tempMem[tempWriteAddr] = shifterOut;
+    }
+    if (instr.IWT) {
+        soundMem[instr.IWA] = bit::sign_extend<24>(m_readValue);
+    }
+
+    if (m_readPending) {
+        uint16 tmp = ReadWRAM();
+        m_readValue = m_readNOFL ? (tmp << 8) : FloatToInt(tmp);
+        m_readPending = false;
+        m_readNOFL = false;
+    } else if (m_writePending) {
+        WriteWRAM();
+        m_writePending = false;
+    }
+
+    uint16 addr = addrs[instr.MASA] + instr.NXADR;
+
+    if (instr.ADREB) {
+        addr += bit::sign_extend<12>(ADRS_REG);
+    }
+
+    if (!instr.TABLE) {
+        addr = (addr + MDEC_CT) & m_RBL;
+    }
+
+    m_readWriteAddr = (addr + m_RBP) & 0x7FFFF;
+
+    if (instr.MRD) {
+        m_readPending = true;
+        m_readNOFL = instr.NOFL;
+    }
+    if (instr.MWT) {
+        m_writePending = true;
+        m_writeValue = instr.NOFL ? (shifterOut >> 8) : IntToFloat(shifterOut);
+    }
+
+    if (instr.ADRL) {
+        if constexpr (shft == 3) {
+            ADRS_REG = (shifterOut >> 12) & 0xFFF;
+        } else {
+            ADRS_REG = (inputs >> 16) & 0xFFF;
+        }
+    }
+}
+
 } // namespace ymir::scsp
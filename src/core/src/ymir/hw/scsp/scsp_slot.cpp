@@ -46,6 +46,7 @@ void Slot::Reset() {
     lfofRaw = 0;
     lfoStepInterval = s_lfoStepTbl[0];
     ampLFOSens = 0;
+    pitchLFOSens = 0;
     ampLFOWaveform = Waveform::Saw;
     pitchLFOWaveform = Waveform::Saw;
 
@@ -65,6 +66,8 @@ void Slot::Reset() {
     currEGRate = releaseRate;
 
     egLevel = 0x3FF;
+    currEGLevel = 0x3FF;
+    egAttackBug = false;
 
     currSample = 0;
     currPhase = 0;
@@ -84,6 +87,7 @@ void Slot::Reset() {
     sample2 = 0;
 
     output = 0;
+    finalLevel = 0;
 
     UpdateMask();
 }
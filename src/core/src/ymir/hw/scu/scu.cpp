@@ -456,6 +456,16 @@ bool SCU::ValidateState(const savestate::SCUSaveState &state) const {
             return false;
         }
         break;
+    case savestate::SCUSaveState::CartType::DRAM48Mbit:
+        if (state.cartData.size() != 6_MiB) {
+            return false;
+        }
+        break;
+    case savestate::SCUSaveState::CartType::ROM:
+        if (state.cartData.size() != cart::kROMCartSize) {
+            return false;
+        }
+        break;
     default: break;
     }
 
@@ -33,6 +33,7 @@ void SCUDSP::Reset(bool hard) {
         for (auto &bank : dataRAM) {
             bank.fill(0);
         }
+        DecodeProgram();
     }
 
     programExecuting = false;
@@ -72,6 +73,8 @@ void SCUDSP::Reset(bool hard) {
     dmaReadAddr = 0;
     dmaWriteAddr = 0;
     dmaAddrInc = 0;
+    dmaAddrD0 = 0;
+    dmaPC = 0;
 
     m_cyclesSpillover = 0u;
 }
@@ -85,6 +88,13 @@ FLATTEN void SCUDSP::Run(uint64 cycles) {
 
     // FIXME: WipEout (USA) needs more accurate timings for the DSP to fix exploding geometry
 
+    if constexpr (!debug) {
+        if (blockExecutor) {
+            RunBlocks(cycles);
+            return;
+        }
+    }
+
     for (uint64 cy = 0; cy < cycles; cy++) {
         // Bail out if not executing
         if (!programExecuting && !programStep) {
@@ -98,40 +108,103 @@ FLATTEN void SCUDSP::Run(uint64 cycles) {
             return;
         }
 
-        // Execute next command and fetch next instruction
-        const DSPInstr instruction = nextInstr;
-        nextInstr = programRAM[PC];
+        if (!StepCycle<debug>()) {
+            return;
+        }
+    }
+}
 
-        // const bool doDMA = dmaRun;
-        if (dmaRun) {
-            dmaPC = PC;
-            // HACK: This fixes Grandia FMVs... what the heck is this DMA doing on real hardware?!?
-            if (RunDMA<debug>(0)) {
-                return;
-            }
+template <bool debug>
+FORCE_INLINE bool SCUDSP::StepCycle() {
+    // Execute next command and fetch next instruction
+    const DSPInstr instruction = nextInstr;
+    nextInstr = programRAM[PC];
+
+    // const bool doDMA = dmaRun;
+    if (dmaRun) {
+        dmaPC = PC;
+        // HACK: This fixes Grandia FMVs... what the heck is this DMA doing on real hardware?!?
+        if (RunDMA<debug>(0)) {
+            return false;
         }
+    }
+
+    switch (instruction.instructionInfo.instructionClass) {
+    case 0b00: Cmd_Operation<debug>(instruction); break;
+    case 0b10: Cmd_LoadImm<debug>(instruction); break;
+    case 0b11: Cmd_Special<debug>(instruction); break;
+    }
 
-        switch (instruction.instructionInfo.instructionClass) {
-        case 0b00: Cmd_Operation<debug>(instruction); break;
-        case 0b10: Cmd_LoadImm<debug>(instruction); break;
-        case 0b11: Cmd_Special<debug>(instruction); break;
+    // TODO: is this correct?
+    /*if (doDMA) {
+        // Run entire DMA if writing to program RAM, otherwise run a single transfer
+        if (!dmaToD0 && dmaDst == 4) {
+            RunDMA<debug>(0);
+        } else {
+            // FIXME/HACK: WipEout (USA) doesn't go past menus if we run less DMA steps here
+            // RunDMA<debug>(1);
+            // RunDMA<debug>(16);
+            RunDMA<debug>(0);
         }
+    }*/
 
-        // TODO: is this correct?
-        /*if (doDMA) {
-            // Run entire DMA if writing to program RAM, otherwise run a single transfer
-            if (!dmaToD0 && dmaDst == 4) {
-                RunDMA<debug>(0);
-            } else {
-                // FIXME/HACK: WipEout (USA) doesn't go past menus if we run less DMA steps here
-                // RunDMA<debug>(1);
-                // RunDMA<debug>(16);
-                RunDMA<debug>(0);
+    // Clear stepping flag to ensure the DSP only runs one command when stepping
+    programStep = false;
+    return true;
+}
+
+void SCUDSP::RunBlocks(uint64 cycles) {
+    uint64 cy = 0;
+    while (cy < cycles) {
+        // Bail out if not executing or paused
+        if ((!programExecuting && !programStep) || programPaused) {
+            RunDMA<false>(0);
+            return;
+        }
+
+        // DMA transfers run alongside commands and may stall or overwrite program RAM, and stepping only runs a single
+        // command; handle these one cycle at a time
+        if (dmaRun || programStep) {
+            if (!StepCycle<false>()) {
+                return;
             }
-        }*/
+            ++cy;
+            continue;
+        }
 
-        // Clear stepping flag to ensure the DSP only runs one command when stepping
-        programStep = false;
+        // Run commands until the program ends or starts a DMA transfer. Nothing else can change the execution state
+        // or program RAM from within the DSP. The instruction in the pipeline may have been placed there by other
+        // means, so it is decoded here; the rest come from the pre-decoded program.
+        FnCommand fn = DecodeCommand(nextInstr);
+        do {
+            const DSPInstr instruction = nextInstr;
+            const FnCommand nextFn = m_decodedProgram[PC];
+            nextInstr = programRAM[PC];
+            (this->*fn)(instruction);
+            fn = nextFn;
+            ++cy;
+        } while (cy < cycles && programExecuting && !dmaRun);
+    }
+}
+
+SCUDSP::FnCommand SCUDSP::DecodeCommand(DSPInstr instr) {
+    switch (instr.instructionInfo.instructionClass) {
+    case 0b00: return &SCUDSP::Cmd_Operation<false>;
+    case 0b10: return &SCUDSP::Cmd_LoadImm<false>;
+    case 0b11:
+        switch (instr.specialInfo.specialControl.specialClass) {
+        case 0b00: return &SCUDSP::Cmd_Special_DMA<false>;
+        case 0b01: return &SCUDSP::Cmd_Special_Jump;
+        case 0b10: return &SCUDSP::Cmd_Special_Loop;
+        default: return &SCUDSP::Cmd_Special_End;
+        }
+    default: return &SCUDSP::Cmd_Invalid;
+    }
+}
+
+void SCUDSP::DecodeProgram() {
+    for (size_t i = 0; i < programRAM.size(); ++i) {
+        m_decodedProgram[i] = DecodeCommand(programRAM[i]);
     }
 }
 
@@ -210,7 +283,9 @@ bool SCUDSP::RunDMA(uint64 cycles) {
             if (useDataRAM) {
                 dataRAM[ctIndex][CT.array[ctIndex]] = value;
             } else if (useProgramRAM) {
-                programRAM[programRAMIndex++].u32 = value;
+                programRAM[programRAMIndex].u32 = value;
+                m_decodedProgram[programRAMIndex] = DecodeCommand(programRAM[programRAMIndex]);
+                programRAMIndex++;
             }
         }
         dmaAddrD0 &= 0x7FF'FFFF;
@@ -288,6 +363,7 @@ void SCUDSP::SaveState(savestate::SCUDSPState &state) const {
     state.dmaWriteAddr = dmaWriteAddr;
     state.dmaAddrInc = dmaAddrInc;
     state.dmaAddrD0 = dmaAddrD0;
+    state.dmaPC = dmaPC;
     state.cyclesSpillover = m_cyclesSpillover;
 }
 
@@ -299,8 +375,12 @@ bool SCUDSP::ValidateState(const savestate::SCUDSPState &state) const {
 }
 
 void SCUDSP::LoadState(const savestate::SCUDSPState &state) {
+    // Only decode commands that changed; restoring a recent state usually leaves the program untouched
     for (size_t i = 0; i < programRAM.size(); ++i) {
-        programRAM[i].u32 = state.programRAM[i];
+        if (programRAM[i].u32 != state.programRAM[i]) {
+            programRAM[i].u32 = state.programRAM[i];
+            m_decodedProgram[i] = DecodeCommand(programRAM[i]);
+        }
     }
     dataRAM = state.dataRAM;
     programExecuting = state.programExecuting;
@@ -333,6 +413,7 @@ void SCUDSP::LoadState(const savestate::SCUDSPState &state) {
     dmaWriteAddr = state.dmaWriteAddr & 0x7FFFFFC;
     dmaAddrInc = state.dmaAddrInc;
     dmaAddrD0 = state.dmaAddrD0 & 0x7FFFFFF;
+    dmaPC = state.dmaPC;
     m_cyclesSpillover = state.cyclesSpillover;
 }
 
@@ -640,4 +721,6 @@ FORCE_INLINE void SCUDSP::Cmd_Special_End(DSPInstr command) {
     }
 }
 
+FORCE_INLINE void SCUDSP::Cmd_Invalid(DSPInstr) {}
+
 } // namespace ymir::scu
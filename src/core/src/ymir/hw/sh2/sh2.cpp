@@ -375,6 +375,7 @@ void SH2::Reset(bool hard, bool watchdogInitiated) {
     m_dmacTraced.fill(false);
 
     WDT.Reset(watchdogInitiated);
+    m_WDTBusValue = 0;
 
     SBYCR.u8 = 0x00;
     m_sleep = false;
@@ -434,8 +435,7 @@ void SH2::DumpCacheAddressTag(std::ostream &out) const {
 template <bool debug, bool emulateCache>
 FLATTEN uint64 SH2::Advance(uint64 cycles, uint64 spilloverCycles) {
     m_cyclesExecuted = spilloverCycles;
-    AdvanceWDT<false>();
-    AdvanceFRT<false>();
+    AdvanceTimers();
 
     if constexpr (debug) {
         if (m_debugSuspend) {
@@ -445,21 +445,59 @@ FLATTEN uint64 SH2::Advance(uint64 cycles, uint64 spilloverCycles) {
     }
     // Skip interpreting instructions if CPU is in sleep or standby mode.
     // Wake up on interrupts.
+    m_sleptThroughAdvance = false;
     if (m_sleep) [[unlikely]] {
         if (m_intrFlags.pending) {
             m_sleep = false;
             PC += 2;
         } else {
+            m_sleptThroughAdvance = true;
             return cycles;
         }
     }
 
-    while (m_cyclesExecuted < cycles) {
+    m_cycleTarget = cycles;
+    Execute<debug, emulateCache>();
+    AdvanceDMA<debug, emulateCache>(m_cyclesExecuted - spilloverCycles);
+    return m_cyclesExecuted;
+}
+
+template <bool debug, bool emulateCache>
+FLATTEN uint64 SH2::Resume(uint64 cycles, uint64 executedCycles) {
+    if (m_sleptThroughAdvance) [[unlikely]] {
+        return cycles;
+    }
+
+    m_cyclesExecuted = executedCycles;
+    m_cycleTarget = cycles;
+    Execute<debug, emulateCache>();
+    AdvanceDMA<debug, emulateCache>(m_cyclesExecuted - executedCycles);
+    return m_cyclesExecuted;
+}
+
+template uint64 SH2::Advance<false, false>(uint64, uint64);
+template uint64 SH2::Advance<false, true>(uint64, uint64);
+template uint64 SH2::Advance<true, false>(uint64, uint64);
+template uint64 SH2::Advance<true, true>(uint64, uint64);
+
+template uint64 SH2::Resume<false, false>(uint64, uint64);
+template uint64 SH2::Resume<false, true>(uint64, uint64);
+template uint64 SH2::Resume<true, false>(uint64, uint64);
+template uint64 SH2::Resume<true, true>(uint64, uint64);
+
+template <bool debug, bool emulateCache>
+FORCE_INLINE void SH2::Execute() {
+    while (m_cyclesExecuted < m_cycleTarget) {
         // [[maybe_unused]] const uint32 prevPC = PC; // debug aid
 
         // TODO: choose between interpreter (cached or uncached) and JIT recompiler
         m_cyclesExecuted += InterpretNext<debug, emulateCache>();
 
+        // Speculation cannot go on past an access to memory it cannot isolate
+        if (m_specWindow != nullptr && m_specWindow->IsAborted()) [[unlikely]] {
+            break;
+        }
+
         // If PC is not in any of these places, something went horribly wrong
 
         // Address bits 28 and 27 are disconnected and games generally don't use these mirrors.
@@ -494,20 +532,12 @@ FLATTEN uint64 SH2::Advance(uint64 cycles, uint64 spilloverCycles) {
             }
         }
     }
-    AdvanceDMA<debug, emulateCache>(m_cyclesExecuted - spilloverCycles);
-    return m_cyclesExecuted;
 }
 
-template uint64 SH2::Advance<false, false>(uint64, uint64);
-template uint64 SH2::Advance<false, true>(uint64, uint64);
-template uint64 SH2::Advance<true, false>(uint64, uint64);
-template uint64 SH2::Advance<true, true>(uint64, uint64);
-
 template <bool debug, bool emulateCache>
 FLATTEN uint64 SH2::Step() {
     m_cyclesExecuted = 0; // so that AdvanceWDT/FRT sync to the scheduler time
-    AdvanceWDT<false>();
-    AdvanceFRT<false>();
+    AdvanceTimers();
     m_cyclesExecuted = InterpretNext<debug, emulateCache>();
     AdvanceDMA<debug, emulateCache>(m_cyclesExecuted);
     return m_cyclesExecuted;
@@ -695,6 +725,17 @@ T SH2::MemRead(uint32 address) {
         if constexpr (peek) {
             return m_bus.Peek<T>(address & 0x7FFFFFF);
         } else {
+            if (m_specWindow != nullptr) [[unlikely]] {
+                return m_specWindow->Read<T>(address & 0x7FFFFFF);
+            }
+            if constexpr (!instrFetch) {
+                if (m_syncMonitor != nullptr) {
+                    if (IsMaster()) {
+                        m_syncMonitor->MarkRead(address);
+                    }
+                    CheckSCUAccess(address);
+                }
+            }
             return m_bus.Read<T>(address & 0x7FFFFFF);
         }
     case 0b010: // associative purge
@@ -791,6 +832,19 @@ void SH2::MemWrite(uint32 address, T value) {
         if constexpr (poke) {
             m_bus.Poke<T>(address & 0x7FFFFFF, value);
         } else {
+            if (m_specWindow != nullptr) [[unlikely]] {
+                m_specWindow->Write<T>(address & 0x7FFFFFF, value);
+                break;
+            }
+            if (m_specObserver != nullptr) [[unlikely]] {
+                m_specObserver->RecordWrite(address);
+            }
+            if (m_syncMonitor != nullptr) {
+                if (!IsMaster()) {
+                    m_syncMonitor->CheckWrite(address);
+                }
+                CheckSCUAccess(address);
+            }
             m_bus.Write<T>(address & 0x7FFFFFF, value);
         }
         break;
@@ -874,6 +928,41 @@ FLATTEN FORCE_INLINE void SH2::RefillPipeline() {
     m_fetchedOpcodes = MemRead<uint32, true, false, emulateCache>(PC);
 }
 
+FLATTEN FORCE_INLINE OpcodeType SH2::FetchDecodedInstruction(uint32 address, uint16 &instr) {
+    // Only the cache and cache-through areas map to memory; everything else goes through the regular path
+    DecodedInstruction *entry = nullptr;
+    const uint32 partition = address >> 29u;
+    if (partition == 0b000 || partition == 0b001 || partition == 0b101) [[likely]] {
+        entry = m_decodeCache->Lookup(address);
+    }
+    if (entry == nullptr) [[unlikely]] {
+        instr = FetchInstruction<false>(address);
+        return DecodeTable::s_instance.opcodes[m_delaySlot][instr];
+    }
+
+    const uint32 index = bit::extract<1>(address);
+    if (index == 0) {
+        // Both halves of the pipeline come from the cache when they are up to date
+        DecodedInstruction &next = entry[1];
+        if (!entry->valid || !next.valid) [[unlikely]] {
+            RefillPipeline<false>();
+            entry->Decode(m_fetchedOpcodes >> 16u);
+            next.Decode(m_fetchedOpcodes);
+        } else {
+            m_fetchedOpcodes = (static_cast<uint32>(entry->instr) << 16u) | next.instr;
+        }
+        instr = entry->instr;
+        return entry->opcode[m_delaySlot];
+    }
+
+    // The second half of the pipeline may be stale if the first instruction modified it
+    instr = m_fetchedOpcodes;
+    if (entry->valid && entry->instr == instr) [[likely]] {
+        return entry->opcode[m_delaySlot];
+    }
+    return DecodeTable::s_instance.opcodes[m_delaySlot][instr];
+}
+
 template <bool emulateCache>
 FLATTEN FORCE_INLINE uint8 SH2::MemReadByte(uint32 address) {
     return MemRead<uint8, false, false, emulateCache>(address);
@@ -987,6 +1076,13 @@ FORCE_INLINE uint64 SH2::AccessCycles(uint32 address) {
     util::unreachable();
 }
 
+FORCE_INLINE bool SH2::IsBusWait(uint32 address, uint32 size, bool write) {
+    if (m_specWindow != nullptr) [[unlikely]] {
+        return m_specWindow->IsBusWait(address);
+    }
+    return m_bus.IsBusWait(address, size, write);
+}
+
 template <bool emulateCache>
 uint64 SH2::AccessCyclesRMWByte(uint32 address) {
     const uint32 partition = (address >> 29u) & 0b111;
@@ -1047,6 +1143,9 @@ FORCE_INLINE_EX uint8 SH2::OnChipRegReadByte(uint32 address) {
     case 0x11:
         if constexpr (!peek) {
             AdvanceFRT<false>();
+            if (m_syncMonitor != nullptr) {
+                m_syncMonitor->SignalInteraction();
+            }
         }
         return FRT.ReadFTCSR<peek>();
     case 0x12:
@@ -1330,6 +1429,9 @@ FORCE_INLINE_EX void SH2::OnChipRegWriteByte(uint32 address, uint8 value) {
     case 0x11:
         if constexpr (!poke) {
             AdvanceFRT<true>();
+            if (m_syncMonitor != nullptr) {
+                m_syncMonitor->SignalInteraction();
+            }
         }
         FRT.WriteFTCSR<poke>(value);
         if (INTC.pending.source == InterruptSource::FRT_OVI || INTC.pending.source == InterruptSource::FRT_OCI ||
@@ -1345,7 +1447,13 @@ FORCE_INLINE_EX void SH2::OnChipRegWriteByte(uint32 address, uint8 value) {
         FRT.WriteFRCL<poke>(value);
         break;
     case 0x14: FRT.WriteOCRH<poke>(value); break;
-    case 0x15: FRT.WriteOCRL<poke>(value); break;
+    case 0x15:
+        if constexpr (!poke) {
+            // The new compare value only applies from now on
+            AdvanceFRT<false>();
+        }
+        FRT.WriteOCRL<poke>(value);
+        break;
     case 0x16:
         if constexpr (!poke) {
             AdvanceFRT<true>();
@@ -1820,12 +1928,12 @@ FORCE_INLINE bool SH2::StepDMAC(uint32 channel) {
         }
     };
 
-    if (m_bus.IsBusWait(ch.srcAddress, xferSize, false)) {
+    if (IsBusWait(ch.srcAddress, xferSize, false)) {
         devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} transfer from {:08X} stalled by bus wait signal", channel,
                                      ch.srcAddress);
         return false;
     }
-    if (m_bus.IsBusWait(ch.dstAddress, xferSize, true)) {
+    if (IsBusWait(ch.dstAddress, xferSize, true)) {
         devlog::trace<grp::dma_xfer>(m_logPrefix, "DMAC{} transfer to {:08X} stalled by bus wait signal", channel,
                                      ch.dstAddress);
         return false;
@@ -1922,6 +2030,16 @@ FORCE_INLINE bool SH2::StepDMAC(uint32 channel) {
 
 template <bool debug, bool emulateCache>
 FORCE_INLINE void SH2::AdvanceDMA(uint64 cycles) {
+    // Nothing to do unless the DMAC is enabled
+    if (!DMAOR.DME) [[likely]] {
+        return;
+    }
+    // Transfers run at the end of each Advance call, so they would happen too early in a window that is later extended
+    // with Resume
+    if (m_specWindow != nullptr) [[unlikely]] {
+        m_specWindow->Abort();
+        return;
+    }
     for (uint32 i = 0; i < 2; ++i) {
         // HACK: run full transfers to fix sprite glitches in Golden Axe - The Duel
         while (StepDMAC<debug, emulateCache>(i)) {
@@ -1980,8 +2098,27 @@ FORCE_INLINE void SH2::AdvanceFRT() {
     }
 }
 
+FORCE_INLINE void SH2::AdvanceTimers() {
+    const uint64 cycles = GetCurrentCycleCount();
+    if (WDT.IsEventDue(cycles)) {
+        AdvanceWDT<false>();
+    }
+    if (FRT.IsEventDue(cycles)) {
+        AdvanceFRT<false>();
+    }
+}
+
 FORCE_INLINE void SH2::TriggerFRTInputCapture() {
+    if (m_specWindow != nullptr) [[unlikely]] {
+        m_specWindow->Defer({SpeculationWindow::DeferredEvent::Type::InputCapture, 0, 0});
+        return;
+    }
+
     // TODO: FRT.TCR.IEDGA
+    AdvanceFRT<false>();
+    if (m_syncMonitor != nullptr) {
+        m_syncMonitor->SignalInteraction();
+    }
     FRT.ICR = FRT.FRC;
     FRT.FTCSR.ICF = 1;
     if (FRT.TIER.ICIE) {
@@ -1995,6 +2132,11 @@ FORCE_INLINE void SH2::TriggerFRTInputCapture() {
 FORCE_INLINE void SH2::SetExternalInterrupt(uint8 level, uint8 vector) {
     assert(level < 16);
 
+    if (m_specWindow != nullptr) [[unlikely]] {
+        m_specWindow->Defer({SpeculationWindow::DeferredEvent::Type::ExternalInterrupt, level, vector});
+        return;
+    }
+
     static constexpr InterruptSource source = InterruptSource::IRL;
 
     INTC.externalVector = vector;
@@ -2011,6 +2153,19 @@ FORCE_INLINE void SH2::SetExternalInterrupt(uint8 level, uint8 vector) {
     }
 }
 
+void SH2::ReplayDeferredEvents(const SpeculationWindow &window) {
+    // The checkpoint does not include the cycle counter of the rolled back Advance call
+    m_cyclesExecuted = m_specStartCycles;
+    for (const SpeculationWindow::DeferredEvent &event : window.GetDeferredEvents()) {
+        switch (event.type) {
+        case SpeculationWindow::DeferredEvent::Type::ExternalInterrupt:
+            SetExternalInterrupt(event.level, event.vector);
+            break;
+        case SpeculationWindow::DeferredEvent::Type::InputCapture: TriggerFRTInputCapture(); break;
+        }
+    }
+}
+
 void SH2::RecalcInterrupts() {
     // Check interrupts and use the vector number of the exception with highest priority
     // See documentation for InterruptSource for related registers and default/tie-breaker priority order
@@ -2227,11 +2382,16 @@ FORCE_INLINE uint64 SH2::InterpretNext() {
     // TODO: emulate or approximate fetch - decode - execute - memory access - writeback pipeline
 
     const uint32 pc = PC;
-    const uint16 instr = FetchInstruction<emulateCache>(pc);
+    uint16 instr;
+    OpcodeType opcode;
+    if (!emulateCache && m_decodeCache != nullptr) {
+        opcode = FetchDecodedInstruction(pc, instr);
+    } else {
+        instr = FetchInstruction<emulateCache>(pc);
+        opcode = DecodeTable::s_instance.opcodes[m_delaySlot][instr];
+    }
     TraceExecuteInstruction<debug>(m_tracer, pc, instr, m_delaySlot);
 
-    const OpcodeType opcode = DecodeTable::s_instance.opcodes[m_delaySlot][instr];
-
     // TODO: check program execution
     switch (opcode) {
     case OpcodeType::NOP: return NOP<debug, emulateCache, false>();
@@ -2669,7 +2829,7 @@ FORCE_INLINE uint64 SH2::MOVWL(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[rn] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2685,7 +2845,7 @@ FORCE_INLINE uint64 SH2::MOVLL(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2714,7 +2874,7 @@ FORCE_INLINE uint64 SH2::MOVWL0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm] + R[0];
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[rn] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2730,7 +2890,7 @@ FORCE_INLINE uint64 SH2::MOVLL0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm] + R[0];
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2758,7 +2918,7 @@ FORCE_INLINE uint64 SH2::MOVWL4(uint16 opcode) {
     DECODE_MD(1u)
     const uint32 address = R[rm] + disp;
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address) + WritebackCycles(rm);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[0] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm);
@@ -2773,7 +2933,7 @@ FORCE_INLINE uint64 SH2::MOVLL4(uint16 opcode) {
     DECODE_NMD(2u)
     const uint32 address = R[rm] + disp;
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         TraceChangeStack<debug>(m_tracer, rn, R[15]);
         AdvancePC<debug, emulateCache, delaySlot>();
@@ -2801,7 +2961,7 @@ FORCE_INLINE uint64 SH2::MOVWLG(uint16 opcode) {
     DECODE_D_U(1u);
     const uint32 address = GBR + disp;
     const uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[0] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         AdvancePC<debug, emulateCache, delaySlot>();
         m_wbReg = 0;
@@ -2815,7 +2975,7 @@ FORCE_INLINE uint64 SH2::MOVLLG(uint16 opcode) {
     DECODE_D_U(2u);
     const uint32 address = GBR + disp;
     const uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[0] = MemReadLong<emulateCache>(address);
         AdvancePC<debug, emulateCache, delaySlot>();
         m_wbReg = 0;
@@ -2843,7 +3003,7 @@ FORCE_INLINE uint64 SH2::MOVWM(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] - 2;
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[rm]);
         TracePushRegisterToStack<debug>(m_tracer, rn, rm, R[15], address);
         R[rn] = address;
@@ -2860,7 +3020,7 @@ FORCE_INLINE uint64 SH2::MOVLM(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] - 4;
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         TracePushRegisterToStack<debug>(m_tracer, rn, rm, R[15], address);
         R[rn] = address;
@@ -2894,7 +3054,7 @@ FORCE_INLINE uint64 SH2::MOVWP(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint16, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), false)) [[likely]] {
         R[rn] = bit::sign_extend<16>(MemReadWord<emulateCache>(address));
         if (rn != rm) {
             R[rm] += 2;
@@ -2914,7 +3074,7 @@ FORCE_INLINE uint64 SH2::MOVLP(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rm];
     uint64 cycles = AccessCycles<uint32, false, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), false)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), false)) [[likely]] {
         R[rn] = MemReadLong<emulateCache>(address);
         if (rn != rm) {
             R[rm] += 4;
@@ -2946,7 +3106,7 @@ FORCE_INLINE uint64 SH2::MOVWS(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn];
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm, rn);
@@ -2961,7 +3121,7 @@ FORCE_INLINE uint64 SH2::MOVLS(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn];
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm, rn);
@@ -2988,7 +3148,7 @@ FORCE_INLINE uint64 SH2::MOVWS0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] + R[0];
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rn, 0);
@@ -3003,7 +3163,7 @@ FORCE_INLINE uint64 SH2::MOVLS0(uint16 opcode) {
     DECODE_NM
     const uint32 address = R[rn] + R[0];
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rn, 0);
@@ -3030,7 +3190,7 @@ FORCE_INLINE uint64 SH2::MOVWS4(uint16 opcode) {
     DECODE_ND4(1u)
     const uint32 address = R[rn] + disp;
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[0]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rn, 0);
@@ -3045,7 +3205,7 @@ FORCE_INLINE uint64 SH2::MOVLS4(uint16 opcode) {
     DECODE_NMD(2u)
     const uint32 address = R[rn] + disp;
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[rm]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(rm, rn);
@@ -3072,7 +3232,7 @@ FORCE_INLINE uint64 SH2::MOVWSG(uint16 opcode) {
     DECODE_D_U(1u)
     const uint32 address = GBR + disp;
     uint64 cycles = AccessCycles<uint16, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint16), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint16), true)) [[likely]] {
         MemWriteWord<debug, emulateCache>(address, R[0]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(0);
@@ -3087,7 +3247,7 @@ FORCE_INLINE uint64 SH2::MOVLSG(uint16 opcode) {
     DECODE_D_U(2u)
     const uint32 address = GBR + disp;
     uint64 cycles = AccessCycles<uint32, true, emulateCache>(address);
-    if (!m_bus.IsBusWait(address, sizeof(uint32), true)) [[likely]] {
+    if (!IsBusWait(address, sizeof(uint32), true)) [[likely]] {
         MemWriteLong<debug, emulateCache>(address, R[0]);
         AdvancePC<debug, emulateCache, delaySlot>();
         cycles += WritebackCycles(0);
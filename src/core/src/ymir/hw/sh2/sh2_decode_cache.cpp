@@ -0,0 +1,72 @@
+#include <ymir/hw/sh2/sh2_decode_cache.hpp>
+
+#include <ymir/util/data_ops.hpp>
+
+namespace ymir::sh2 {
+
+DecodeCache::DecodeCache(sys::SH2Bus &bus)
+    : m_bus(bus) {
+    m_blocks.fill(nullptr);
+    m_bus.SetArrayWriteCallback(
+        [](uint32 address, uint32 size, void *ctx) { static_cast<DecodeCache *>(ctx)->Invalidate(address, size); },
+        this);
+}
+
+DecodeCache::~DecodeCache() {
+    m_bus.SetArrayWriteCallback(nullptr, nullptr);
+    m_bus.UntrackArrayWrites();
+}
+
+void DecodeCache::AddRegion(uint32 start, uint32 end) {
+    m_regions.push_back({start & kAddressMask, end & kAddressMask});
+}
+
+void DecodeCache::Flush() {
+    ++m_generation;
+}
+
+void DecodeCache::Revalidate() {
+    for (auto &block : m_blockStorage) {
+        if (block->generation != m_generation) {
+            continue;
+        }
+        const uint8 *memory = m_bus.GetArrayPointer(block->address);
+        for (uint32 i = 0; i < kBlockEntries; ++i) {
+            DecodedInstruction &entry = block->entries[i];
+            if (entry.valid && entry.instr != util::ReadBE<uint16>(&memory[i * sizeof(uint16)])) {
+                entry.valid = false;
+            }
+        }
+    }
+}
+
+void DecodeCache::Block::Clear(uint64 newGeneration) {
+    for (DecodedInstruction &entry : entries) {
+        entry.valid = false;
+    }
+    generation = newGeneration;
+}
+
+DecodeCache::Block *DecodeCache::AllocateBlock(uint32 address) {
+    bool cacheable = false;
+    for (const Region &region : m_regions) {
+        if (address >= region.start && address <= region.end) {
+            cacheable = true;
+            break;
+        }
+    }
+    if (!cacheable || m_bus.GetArrayPointer(address) == nullptr) {
+        return nullptr;
+    }
+
+    auto &block = m_blockStorage.emplace_back(std::make_unique<Block>());
+    block->Clear(m_generation);
+    block->address = address & ~kBlockMask;
+
+    // Share the block with every mirror of this memory and have the bus notify us of writes to any of them
+    m_bus.TrackArrayWrites(block->address,
+                           [&](uint32 mirrorAddress) { m_blocks[mirrorAddress >> kBlockBits] = block.get(); });
+    return block.get();
+}
+
+} // namespace ymir::sh2
@@ -0,0 +1,161 @@
+#include <ymir/hw/sh2/sh2_speculation.hpp>
+
+#include <ymir/hw/sh2/sh2.hpp>
+
+#include <ymir/util/thread_name.hpp>
+#include <ymir/util/thread_placement.hpp>
+#include <ymir/util/thread_pool.hpp>
+
+#include <cstring>
+
+namespace ymir::sh2 {
+
+// -----------------------------------------------------------------------------
+// SpeculationWindow
+
+SpeculationWindow::SpeculationWindow(sys::SH2Bus &bus)
+    : m_bus(bus) {
+    m_shadowPages.fill(nullptr);
+    Begin();
+}
+
+void SpeculationWindow::Begin() {
+    m_readPages.fill(0);
+    m_writtenPages.fill(0);
+    m_otherWrittenPages.fill(0);
+    for (const uint32 page : m_shadowedPages) {
+        m_shadowPages[page] = nullptr;
+    }
+    m_shadowedPages.clear();
+    m_writeLog.clear();
+    m_deferredEvents.clear();
+    m_aborted = false;
+}
+
+bool SpeculationWindow::HasConflict() const {
+    if (m_aborted || !m_deferredEvents.empty()) {
+        return true;
+    }
+    for (size_t i = 0; i < m_otherWrittenPages.size(); ++i) {
+        if (m_otherWrittenPages[i] & (m_readPages[i] | m_writtenPages[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SpeculationWindow::Commit() {
+    for (const LoggedWrite &write : m_writeLog) {
+        switch (write.size) {
+        case sizeof(uint8): m_bus.Write<uint8>(write.address, write.value); break;
+        case sizeof(uint16): m_bus.Write<uint16>(write.address, write.value); break;
+        case sizeof(uint32): m_bus.Write<uint32>(write.address, write.value); break;
+        }
+    }
+}
+
+uint8 *SpeculationWindow::AllocateShadowPage(uint32 page, uint32 address) {
+    if (m_shadowedPages.size() == m_shadowPool.size()) {
+        m_shadowPool.push_back(std::make_unique<ShadowPage>());
+    }
+    uint8 *shadow = m_shadowPool[m_shadowedPages.size()]->data();
+    std::memcpy(shadow, m_bus.GetArrayPointer(address & ~kPageMask), kPageSize);
+    m_shadowPages[page] = shadow;
+    m_shadowedPages.push_back(page);
+    return shadow;
+}
+
+// -----------------------------------------------------------------------------
+// SpeculativeRunner
+
+SpeculativeRunner::SpeculativeRunner(SH2 &master, SH2 &slave, sys::SH2Bus &bus)
+    : m_master(master)
+    , m_slave(slave)
+    , m_window(bus) {}
+
+SpeculativeRunner::~SpeculativeRunner() {
+    SetEnabled(false);
+}
+
+void SpeculativeRunner::SetEnabled(bool enabled) {
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+
+    if (enabled) {
+        m_quit = false;
+        m_thread = util::ThreadPool::Shared().StartDedicated([this] { WorkerLoop(); });
+    } else if (m_thread.joinable()) {
+        m_quit = true;
+        m_requested.fetch_add(1, std::memory_order_release);
+        m_requested.notify_one();
+        m_thread.join();
+        m_completed = m_requested.load();
+    }
+}
+
+void SpeculativeRunner::Start(uint64 cycles, uint64 spilloverCycles) {
+    m_slave.SaveState(m_checkpoint);
+    m_window.Begin();
+    m_slave.Speculate(&m_window);
+    m_master.ObserveSpeculation(&m_window);
+
+    m_cycles = cycles;
+    m_spilloverCycles = spilloverCycles;
+    m_requested.fetch_add(1, std::memory_order_release);
+    m_requested.notify_one();
+}
+
+bool SpeculativeRunner::Finish(uint64 &slaveCycles) {
+    // Windows are short, so spin for a while before going to sleep
+    const uint64 requested = m_requested.load(std::memory_order_relaxed);
+    uint64 completed = m_completed.load(std::memory_order_acquire);
+    for (uint32 spins = 0; completed != requested; ++spins) {
+        if (spins < 4096) {
+            std::this_thread::yield();
+        } else {
+            m_completed.wait(completed, std::memory_order_acquire);
+        }
+        completed = m_completed.load(std::memory_order_acquire);
+    }
+
+    m_master.ObserveSpeculation(nullptr);
+    m_slave.Speculate(nullptr);
+
+    if (!m_window.HasConflict()) {
+        m_window.Commit();
+        slaveCycles = m_result;
+        return true;
+    }
+
+    m_slave.LoadState(m_checkpoint);
+    m_slave.ReplayDeferredEvents(m_window);
+    return false;
+}
+
+void SpeculativeRunner::WorkerLoop() {
+    util::SetCurrentThreadName("Slave SH-2 thread");
+    util::ScopedThreadPlacement placement{util::ThreadRole::SH2Speculation};
+
+    uint64 handled = m_completed.load(std::memory_order_relaxed);
+    while (true) {
+        for (uint32 spins = 0; spins < 4096 && m_requested.load(std::memory_order_acquire) == handled; ++spins) {
+            std::this_thread::yield();
+        }
+        m_requested.wait(handled, std::memory_order_acquire);
+        const uint64 requested = m_requested.load(std::memory_order_acquire);
+        if (m_quit) {
+            break;
+        }
+        if (requested == handled) {
+            continue;
+        }
+        m_result = m_slave.Advance<false, false>(m_cycles, m_spilloverCycles);
+        handled = requested;
+        m_completed.store(handled, std::memory_order_release);
+        m_completed.notify_one();
+    }
+}
+
+} // namespace ymir::sh2
@@ -219,7 +219,9 @@ void SMPC::LoadState(const savestate::SMPCSaveState &state) {
     WriteDDR1(state.DDR1);
     WriteDDR2(state.DDR2);
     WriteIOSEL(state.IOSEL);
-    WriteEXLE(state.EXLE);
+    // Restore the latch enables without re-reading the ports, which would overwrite the PDRs restored above
+    m_extLatchEnable1 = bit::test<0>(state.EXLE);
+    m_extLatchEnable2 = bit::test<1>(state.EXLE);
 
     m_getPeripheralData = state.intback.getPeripheralData;
     m_optimize = state.intback.optimize;
@@ -4,11 +4,16 @@
 #include <ymir/util/dev_log.hpp>
 #include <ymir/util/inline.hpp>
 #include <ymir/util/thread_name.hpp>
+#include <ymir/util/thread_placement.hpp>
+#include <ymir/util/thread_pool.hpp>
 #include <ymir/util/unreachable.hpp>
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <limits>
+#include <utility>
 
 #if defined(_M_X64) || defined(__x86_64__)
     #include <immintrin.h>
@@ -92,6 +97,7 @@ void SoftwareVDPRenderer::Reset(bool hard) {
     m_HRes = vdp::kDefaultResH;
     m_VRes = vdp::kDefaultResV;
     m_exclusiveMonitor = false;
+    m_VDP1doubleV = 0;
 
     if (hard) {
         m_CRAMCache.fill({});
@@ -103,9 +109,10 @@ void SoftwareVDPRenderer::Reset(bool hard) {
         m_framebuffer.fill(0xFF000000);
     }
 
-    for (auto &state : m_vramFetchers) {
-        state[0].Reset();
-        state[1].Reset();
+    for (auto &fetchers : m_vramFetchers) {
+        for (auto &fetcher : fetchers) {
+            fetcher.Reset();
+        }
     }
 
     for (auto &output : m_layerOutputs) {
@@ -146,7 +153,7 @@ void SoftwareVDPRenderer::EnableThreadedVDP1(bool enable) {
     m_threadedVDP1Rendering = enable;
     if (enable) {
         m_vdp1RenderingContext.EnqueueEvent(VDP1RenderEvent::PostLoadStateSync());
-        m_VDP1RenderThread = std::thread{[&] { VDP1RenderThread(); }};
+        m_VDP1RenderThread = util::ThreadPool::Shared().StartDedicated([&] { VDP1RenderThread(); });
         m_vdp1RenderingContext.postLoadSyncSignal.Wait();
         m_vdp1RenderingContext.postLoadSyncSignal.Reset();
     } else {
@@ -171,8 +178,9 @@ void SoftwareVDPRenderer::EnableThreadedVDP2(bool enable) {
     m_threadedVDP2Rendering = enable;
     if (enable) {
         m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::PostLoadStateSync());
-        m_VDP2RenderThread = std::thread{[&] { VDP2RenderThread(); }};
-        m_VDP2DeinterlaceRenderThread = std::thread{[&] { VDP2DeinterlaceRenderThread(); }};
+        m_VDP2RenderThread = util::ThreadPool::Shared().StartDedicated([&] { VDP2RenderThread(); });
+        m_VDP2DeinterlaceRenderThread =
+            util::ThreadPool::Shared().StartDedicated([&] { VDP2DeinterlaceRenderThread(); });
         m_vdp2RenderingContext.postLoadSyncSignal.Wait();
         m_vdp2RenderingContext.postLoadSyncSignal.Reset();
     } else {
@@ -527,15 +535,18 @@ void SoftwareVDPRenderer::VDP2BeginFrame() {
 
 void SoftwareVDPRenderer::VDP2RenderLine(uint32 y) {
     if (m_threadedVDP2Rendering) {
-        m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2DrawLine(y));
+        m_vdp2RenderingContext.EnqueueEvent(VDP2RenderEvent::VDP2DrawLine(y, !m_shadowFrame));
         m_state.state2.CalcAccessPatterns(m_state.regs2, m_vdp2AccessPatternsConfig);
         m_state.state2.CalcVCellScrollDelay(m_state.regs2);
     } else {
         const bool interlaced = m_state.regs2.TVMD.IsInterlaced();
         VDP2PrepareLine(y);
-        (this->*m_fnVDP2DrawLine)(y, false);
-        if (m_enhancements.deinterlace && interlaced) {
-            (this->*m_fnVDP2DrawLine)(y, true);
+        // Shadow frames only need to keep the line state up to date; skip drawing and composition
+        if (!m_shadowFrame) {
+            (this->*m_fnVDP2DrawLine)(y, false);
+            if (m_enhancements.deinterlace && interlaced) {
+                (this->*m_fnVDP2DrawLine)(y, true);
+            }
         }
         VDP2FinishLine(y);
     }
@@ -552,7 +563,9 @@ void SoftwareVDPRenderer::VDP2EndFrame() {
         Callbacks.VDP2ResolutionChanged(m_HRes, m_VRes);
     }
     Callbacks.VDP2DrawFinished();
-    SwCallbacks.FrameComplete(m_framebuffer.data(), m_HRes, m_VRes);
+    if (!m_shadowFrame) {
+        SwCallbacks.FrameComplete(m_framebuffer.data(), m_HRes, m_VRes);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -589,6 +602,7 @@ void SoftwareVDPRenderer::DumpExtraVDP1Framebuffers(std::ostream &out) const {
 
 void SoftwareVDPRenderer::VDP1RenderThread() {
     util::SetCurrentThreadName("VDP1 render thread");
+    util::ScopedThreadPlacement placement{util::ThreadRole::VDP1Render};
 
     auto &rctx = m_vdp1RenderingContext;
 
@@ -659,6 +673,7 @@ void SoftwareVDPRenderer::VDP1RenderThread() {
 
 void SoftwareVDPRenderer::VDP2RenderThread() {
     util::SetCurrentThreadName("VDP2 render thread");
+    util::ScopedThreadPlacement placement{util::ThreadRole::VDP2Render};
 
     auto &rctx = m_vdp2RenderingContext;
 
@@ -688,10 +703,16 @@ void SoftwareVDPRenderer::VDP2RenderThread() {
             case EvtType::VDP2UpdateEnabledBGs: VDP2UpdateEnabledBGs(); break;
             case EvtType::VDP2DrawLine: //
             {
+                const bool render = event.drawLine.render;
                 const bool deinterlaceRender = m_enhancements.deinterlace;
                 const bool threadedDeinterlacer = m_threadedDeinterlacer;
                 const bool interlaced = rctx.vdp2.regs.TVMD.IsInterlaced();
                 VDP2PrepareLine(event.drawLine.vcnt);
+                if (!render) {
+                    // Shadow frame; only keep the line state up to date
+                    VDP2FinishLine(event.drawLine.vcnt);
+                    break;
+                }
                 if (deinterlaceRender && interlaced && threadedDeinterlacer) {
                     rctx.deinterlaceY = event.drawLine.vcnt;
                     rctx.deinterlaceRenderBeginSignal.Set();
@@ -799,6 +820,7 @@ void SoftwareVDPRenderer::VDP2RenderThread() {
 
 void SoftwareVDPRenderer::VDP2DeinterlaceRenderThread() {
     util::SetCurrentThreadName("VDP deinterlace render thread");
+    util::ScopedThreadPlacement placement{util::ThreadRole::VDPDeinterlace};
 
     auto &rctx = m_vdp2RenderingContext;
 
@@ -825,6 +847,10 @@ FORCE_INLINE T SoftwareVDPRenderer::VDP1ReadRendererVRAM(uint32 address) {
     }
 }
 
+FORCE_INLINE std::array<uint8, kVDP1VRAMSize> &SoftwareVDPRenderer::VDP1GetRendererVRAM() {
+    return m_threadedVDP1Rendering ? m_vdp1RenderingContext.vdp1.mem.VRAM : m_state.mem1.VRAM;
+}
+
 FORCE_INLINE std::array<uint8, kVDP2VRAMSize> &SoftwareVDPRenderer::VDP2GetRendererVRAM() {
     return m_threadedVDP2Rendering ? m_vdp2RenderingContext.vdp2.mem.VRAM : m_state.mem2.VRAM;
 }
@@ -875,6 +901,128 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2UpdateCRAMCache(uint32 address) {
 // -----------------------------------------------------------------------------
 // VDP1
 
+// Expands packed 4-bit texels into one byte per texel, high nibble first
+FORCE_INLINE static void VDP1ExpandNibbles(const uint8 *src, uint8 *dst, uint32 count) {
+    uint32 i = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__SSE2__)
+    // 16 bytes at a time
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    for (; i + 16 <= count; i += 16) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[i]));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+        const __m128i lo = _mm_and_si128(packed, nibbleMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i * 2]), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[i * 2 + 16]), _mm_unpackhi_epi8(hi, lo));
+    }
+    #endif
+#endif
+
+    for (; i < count; i++) {
+        dst[i * 2 + 0] = src[i] >> 4u;
+        dst[i * 2 + 1] = src[i] & 0xF;
+    }
+}
+
+// Finds the first texel with the given value, returning the number of texels if there are none
+FORCE_INLINE static uint32 VDP1FindTexel(std::span<const uint8> texels, uint8 value) {
+    uint32 i = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__SSE2__)
+    // 16 at a time
+    const __m128i value_x16 = _mm_set1_epi8(static_cast<char>(value));
+    for (; i + 16 <= texels.size(); i += 16) {
+        const __m128i texel_x16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&texels[i]));
+        const uint32 matches = _mm_movemask_epi8(_mm_cmpeq_epi8(texel_x16, value_x16));
+        if (matches != 0) {
+            return i + std::countr_zero(matches);
+        }
+    }
+    #endif
+#endif
+
+    for (; i < texels.size(); i++) {
+        if (texels[i] == value) {
+            return i;
+        }
+    }
+    return texels.size();
+}
+
+// Converts bank mode texels into colors and marks the opaque ones
+FORCE_INLINE static void VDP1ExpandBankTexels(const uint8 *texels, uint16 *colors, uint8 *opaque, uint32 count,
+                                              uint8 texelMask, uint16 colorBank, bool transparentPixelDisable) {
+    uint32 i = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__SSE2__)
+    // 16 at a time
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i forceOpaque = transparentPixelDisable ? ones : zero;
+    const __m128i texelMask_x16 = _mm_set1_epi8(static_cast<char>(texelMask));
+    const __m128i colorBank_x8 = _mm_set1_epi16(static_cast<short>(colorBank));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i texel_x16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&texels[i]));
+
+        // Texel value zero is transparent
+        const __m128i opaque_x16 = _mm_or_si128(_mm_xor_si128(_mm_cmpeq_epi8(texel_x16, zero), ones), forceOpaque);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&opaque[i]), opaque_x16);
+
+        const __m128i index_x16 = _mm_and_si128(texel_x16, texelMask_x16);
+        const __m128i colorLo_x8 = _mm_or_si128(_mm_unpacklo_epi8(index_x16, zero), colorBank_x8);
+        const __m128i colorHi_x8 = _mm_or_si128(_mm_unpackhi_epi8(index_x16, zero), colorBank_x8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&colors[i]), colorLo_x8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&colors[i + 8]), colorHi_x8);
+    }
+    #endif
+#endif
+
+    for (; i < count; i++) {
+        opaque[i] = texels[i] != 0 || transparentPixelDisable ? 0xFF : 0x00;
+        colors[i] = (texels[i] & texelMask) | colorBank;
+    }
+}
+
+// Writes the opaque pixels of a row into a 16-bit framebuffer, replacing its contents.
+// Clears the matching pixels of the mesh framebuffer if one is given.
+FORCE_INLINE static void VDP1BlitReplaceRow(const uint16 *colors, const uint8 *opaque, uint8 *dst, uint8 *meshDst,
+                                            uint32 count) {
+    uint32 i = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__SSE2__)
+    // 8 at a time
+    for (; i + 8 <= count; i += 8) {
+        const __m128i color_x8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&colors[i]));
+        const __m128i colorBE_x8 = _mm_or_si128(_mm_slli_epi16(color_x8, 8), _mm_srli_epi16(color_x8, 8));
+        const __m128i opaque_x8 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&opaque[i]));
+        const __m128i mask_x8 = _mm_unpacklo_epi8(opaque_x8, opaque_x8);
+
+        __m128i *dstPtr = reinterpret_cast<__m128i *>(&dst[i * sizeof(uint16)]);
+        const __m128i dst_x8 = _mm_loadu_si128(dstPtr);
+        _mm_storeu_si128(dstPtr, _mm_or_si128(_mm_and_si128(mask_x8, colorBE_x8), _mm_andnot_si128(mask_x8, dst_x8)));
+
+        if (meshDst != nullptr) {
+            __m128i *meshPtr = reinterpret_cast<__m128i *>(&meshDst[i * sizeof(uint16)]);
+            _mm_storeu_si128(meshPtr, _mm_andnot_si128(mask_x8, _mm_loadu_si128(meshPtr)));
+        }
+    }
+    #endif
+#endif
+
+    for (; i < count; i++) {
+        if (opaque[i]) {
+            util::WriteBE<uint16>(&dst[i * sizeof(uint16)], colors[i]);
+            if (meshDst != nullptr) {
+                util::WriteBE<uint16>(&meshDst[i * sizeof(uint16)], 0);
+            }
+        }
+    }
+}
+
 FORCE_INLINE VDP1Regs &SoftwareVDPRenderer::VDP1GetRegs() {
     return m_state.regs1;
 }
@@ -1053,19 +1201,64 @@ bool SoftwareVDPRenderer::VDP1IsQuadSystemClipped(CoordS32 coord1, CoordS32 coor
     return false;
 }
 
-template <bool deinterlace, bool transparentMeshes>
+FORCE_INLINE Color555 SoftwareVDPRenderer::VDP1CalcPixelColor(VDP1PixelOp op, Color555 srcColor,
+                                                              Color555 dstColor) {
+    // In all cases where calculation is done, the raw color data to be drawn ("original graphic") or from the
+    // background are interpreted as 5:5:5 RGB.
+    switch (op) {
+    case VDP1PixelOp::Replace:
+        dstColor = srcColor;
+        break;
+    case VDP1PixelOp::Shadow:
+        // Halve destination luminosity if it's not transparent
+        if (dstColor.msb) {
+            dstColor.r >>= 1u;
+            dstColor.g >>= 1u;
+            dstColor.b >>= 1u;
+        }
+        break;
+    case VDP1PixelOp::HalfLuminance:
+        // Draw original graphic with halved luminance
+        dstColor.r = srcColor.r >> 1u;
+        dstColor.g = srcColor.g >> 1u;
+        dstColor.b = srcColor.b >> 1u;
+        dstColor.msb = srcColor.msb;
+        break;
+    case VDP1PixelOp::HalfTransparency:
+        // If background is not transparent, blend half of original graphic and half of background
+        // Otherwise, draw original graphic as is
+        if (dstColor.msb) {
+            dstColor.r = (srcColor.r + dstColor.r) >> 1u;
+            dstColor.g = (srcColor.g + dstColor.g) >> 1u;
+            dstColor.b = (srcColor.b + dstColor.b) >> 1u;
+        } else {
+            dstColor = srcColor;
+        }
+        break;
+    default: break;
+    }
+    return dstColor;
+}
+
+template <bool deinterlace, bool transparentMeshes, SoftwareVDPRenderer::VDP1PixelOp pixelOp, bool gouraud, bool mesh>
 FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotPixel(CoordS32 coord, const VDP1PixelParams &pixelParams,
                                                      const VDP1Regs &regs1, bool doubleDensity) {
 
     auto [x, y] = coord;
 
+    // Specialized kernels fold these into constants
+    constexpr bool dynamic = pixelOp == VDP1PixelOp::Dynamic;
+    const VDP1PixelOp op = dynamic ? VDP1GetPixelOp(pixelParams.mode) : pixelOp;
+    const bool meshEnable = dynamic ? static_cast<bool>(pixelParams.mode.meshEnable) : mesh;
+    const bool gouraudEnable = dynamic ? static_cast<bool>(pixelParams.mode.gouraudEnable) : gouraud;
+
     // Reject pixels outside of clipping area
     if (VDP1IsPixelClipped<deinterlace>(coord, pixelParams.mode.userClippingEnable, pixelParams.mode.clippingMode)) {
         return false;
     }
 
     if constexpr (!transparentMeshes) {
-        if (pixelParams.mode.meshEnable && ((x ^ y) & 1)) {
+        if (meshEnable && ((x ^ y) & 1)) {
             return true;
         }
     }
@@ -1088,9 +1281,9 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotPixel(CoordS32 coord, const VDP1P
     if (regs1.pixel8Bits) {
         fbOffset &= 0x3FFFF;
         // TODO: what happens if pixelParams.mode.colorCalcBits/gouraudEnable != 0?
-        if (pixelParams.mode.msbOn) {
+        if (op == VDP1PixelOp::MSBOn) {
             drawFB[fbOffset] |= 0x80;
-        } else if (transparentMeshes && pixelParams.mode.meshEnable) {
+        } else if (transparentMeshes && meshEnable) {
             m_meshFB[altFB][fbIndex][fbOffset] = pixelParams.color;
         } else {
             drawFB[fbOffset] = pixelParams.color;
@@ -1102,55 +1295,20 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotPixel(CoordS32 coord, const VDP1P
         fbOffset = (fbOffset * sizeof(uint16)) & 0x3FFFE;
         uint8 *pixel = &drawFB[fbOffset];
 
-        if (pixelParams.mode.msbOn) {
+        if (op == VDP1PixelOp::MSBOn) {
             *pixel |= 0x80;
         } else {
             Color555 srcColor{.u16 = pixelParams.color};
             Color555 dstColor{.u16 = util::ReadBE<uint16>(pixel)};
 
-            // Apply color calculations
-            //
-            // In all cases where calculation is done, the raw color data to be drawn ("original graphic") or from
-            // the background are interpreted as 5:5:5 RGB.
-
-            if (pixelParams.mode.gouraudEnable) {
+            if (gouraudEnable) {
                 // Apply gouraud shading to source color
                 srcColor = pixelParams.gouraud.Blend(srcColor);
             }
 
-            switch (pixelParams.mode.colorCalcBits) {
-            case 0: // Replace
-                dstColor = srcColor;
-                break;
-            case 1: // Shadow
-                // Halve destination luminosity if it's not transparent
-                if (dstColor.msb) {
-                    dstColor.r >>= 1u;
-                    dstColor.g >>= 1u;
-                    dstColor.b >>= 1u;
-                }
-                break;
-            case 2: // Half-luminance
-                // Draw original graphic with halved luminance
-                dstColor.r = srcColor.r >> 1u;
-                dstColor.g = srcColor.g >> 1u;
-                dstColor.b = srcColor.b >> 1u;
-                dstColor.msb = srcColor.msb;
-                break;
-            case 3: // Half-transparency
-                // If background is not transparent, blend half of original graphic and half of background
-                // Otherwise, draw original graphic as is
-                if (dstColor.msb) {
-                    dstColor.r = (srcColor.r + dstColor.r) >> 1u;
-                    dstColor.g = (srcColor.g + dstColor.g) >> 1u;
-                    dstColor.b = (srcColor.b + dstColor.b) >> 1u;
-                } else {
-                    dstColor = srcColor;
-                }
-                break;
-            }
+            dstColor = VDP1CalcPixelColor(op, srcColor, dstColor);
 
-            if (transparentMeshes && pixelParams.mode.meshEnable) {
+            if (transparentMeshes && meshEnable) {
                 util::WriteBE<uint16>(&m_meshFB[altFB][fbIndex][fbOffset], dstColor.u16);
             } else {
                 util::WriteBE<uint16>(pixel, dstColor.u16);
@@ -1209,10 +1367,10 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotLine(CoordS32 coord1, CoordS32 co
     return plotted;
 }
 
-template <bool deinterlace, bool transparentMeshes>
-FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, CoordS32 coord2,
-                                                            VDP1TexturedLineParams &lineParams, const VDP1Regs &regs1,
-                                                            bool doubleDensity) {
+template <bool deinterlace, bool transparentMeshes, uint8 colorMode, SoftwareVDPRenderer::VDP1PixelOp pixelOp,
+          bool gouraud, bool mesh>
+bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, CoordS32 coord2, VDP1TexturedLineParams &lineParams,
+                                               const VDP1Regs &regs1, bool doubleDensity) {
     if (VDP1IsLineSystemClipped<deinterlace>(coord1, coord2)) {
         return false;
     }
@@ -1222,7 +1380,13 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
     const uint32 charSizeH = std::max<uint32>(lineParams.charSizeH, 1u);
     const auto mode = lineParams.mode;
     const auto control = lineParams.control;
-    if (mode.colorMode == 5) {
+
+    // Specialized kernels fold these into constants
+    constexpr bool dynamic = pixelOp == VDP1PixelOp::Dynamic;
+    const uint8 texelMode = dynamic ? static_cast<uint8>(mode.colorMode) : colorMode;
+    const bool gouraudEnable = dynamic ? static_cast<bool>(mode.gouraudEnable) : gouraud;
+
+    if (texelMode == 5) {
         // Force-align character address in 16 bpp RGB mode
         lineParams.charAddr &= ~0xF;
     }
@@ -1235,7 +1399,7 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
     VDP1PixelParams pixelParams{
         .mode = mode,
     };
-    if (mode.gouraudEnable) {
+    if (gouraudEnable) {
         assert(lineParams.gouraudLeft != nullptr);
         assert(lineParams.gouraudRight != nullptr);
         pixelParams.gouraud.Setup(line.Length() + 1, lineParams.gouraudLeft->Value(), lineParams.gouraudRight->Value());
@@ -1273,46 +1437,39 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
         };
 
         // Read next texel
-        switch (mode.colorMode) {
-        case 0: // 4 bpp, 16 colors, bank mode
+        if (texelMode == 0) { // 4 bpp, 16 colors, bank mode
             color = VDP1ReadRendererVRAM<uint8>(lineParams.charAddr + (charIndex >> 1));
             color = (color >> ((~u & 1) * 4)) & 0xF;
             processEndCode(color == 0xF);
             transparent = color == 0x0;
             color |= lineParams.colorBank;
-            break;
-        case 1: // 4 bpp, 16 colors, lookup table mode
+        } else if (texelMode == 1) { // 4 bpp, 16 colors, lookup table mode
             color = VDP1ReadRendererVRAM<uint8>(lineParams.charAddr + (charIndex >> 1));
             color = (color >> ((~u & 1) * 4)) & 0xF;
             processEndCode(color == 0xF);
             transparent = color == 0x0;
             color = VDP1ReadRendererVRAM<uint16>(color * sizeof(uint16) + lineParams.colorBank);
-            break;
-        case 2: // 8 bpp, 64 colors, bank mode
+        } else if (texelMode == 2) { // 8 bpp, 64 colors, bank mode
             color = VDP1ReadRendererVRAM<uint8>(lineParams.charAddr + charIndex);
             processEndCode(color == 0xFF);
             transparent = color == 0x00;
             color &= 0x3F;
             color |= lineParams.colorBank;
-            break;
-        case 3: // 8 bpp, 128 colors, bank mode
+        } else if (texelMode == 3) { // 8 bpp, 128 colors, bank mode
             color = VDP1ReadRendererVRAM<uint8>(lineParams.charAddr + charIndex);
             processEndCode(color == 0xFF);
             transparent = color == 0x00;
             color &= 0x7F;
             color |= lineParams.colorBank;
-            break;
-        case 4: // 8 bpp, 256 colors, bank mode
+        } else if (texelMode == 4) { // 8 bpp, 256 colors, bank mode
             color = VDP1ReadRendererVRAM<uint8>(lineParams.charAddr + charIndex);
             processEndCode(color == 0xFF);
             transparent = color == 0x00;
             color |= lineParams.colorBank;
-            break;
-        case 5: // 16 bpp, 32768 colors, RGB mode
+        } else if (texelMode == 5) { // 16 bpp, 32768 colors, RGB mode
             color = VDP1ReadRendererVRAM<uint16>(lineParams.charAddr + charIndex * sizeof(uint16));
             processEndCode(color == 0x7FFF);
             transparent = !bit::test<15>(color);
-            break;
         }
     };
 
@@ -1336,7 +1493,7 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
         uStepper.StepPixel();
 
         if (hasEndCode || (transparent && !mode.transparentPixelDisable)) {
-            if (mode.gouraudEnable) {
+            if (gouraudEnable) {
                 pixelParams.gouraud.Step();
             }
 
@@ -1365,11 +1522,11 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
 
         pixelParams.color = color;
 
-        bool plottedPixel =
-            VDP1PlotPixel<deinterlace, transparentMeshes>(line.Coord(), pixelParams, regs1, doubleDensity);
+        bool plottedPixel = VDP1PlotPixel<deinterlace, transparentMeshes, pixelOp, gouraud, mesh>(
+            line.Coord(), pixelParams, regs1, doubleDensity);
         if (aa) {
-            plottedPixel |=
-                VDP1PlotPixel<deinterlace, transparentMeshes>(line.AACoord(), pixelParams, regs1, doubleDensity);
+            plottedPixel |= VDP1PlotPixel<deinterlace, transparentMeshes, pixelOp, gouraud, mesh>(
+                line.AACoord(), pixelParams, regs1, doubleDensity);
         }
         if (plottedPixel) {
             plotted = true;
@@ -1378,7 +1535,7 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
             break;
         }
 
-        if (mode.gouraudEnable) {
+        if (gouraudEnable) {
             pixelParams.gouraud.Step();
         }
     }
@@ -1402,6 +1559,28 @@ FORCE_INLINE bool SoftwareVDPRenderer::VDP1PlotTexturedLine(CoordS32 coord1, Coo
     return plotted;
 }
 
+template <bool deinterlace, bool transparentMeshes>
+SoftwareVDPRenderer::FnVDP1PlotTexturedLine
+SoftwareVDPRenderer::VDP1SelectTexturedLineKernel(VDP1Command::DrawMode mode) {
+    // Kernels are indexed by color mode, pixel operation, gouraud shading and mesh.
+    // Invalid color modes share a kernel that reads no texels. Gouraud shading has no effect on shadows and MSB-on.
+    static constexpr size_t kNumPixelOps = 5;
+    static constexpr auto kKernels = []<size_t... indices>(std::index_sequence<indices...>) {
+        constexpr auto kernel = []<size_t index>() -> FnVDP1PlotTexturedLine {
+            constexpr auto colorMode = static_cast<uint8>(std::min<size_t>(index / (kNumPixelOps * 4), 6));
+            constexpr auto pixelOp = static_cast<VDP1PixelOp>((index / 4) % kNumPixelOps + 1);
+            constexpr bool gouraud = (index & 2) && pixelOp != VDP1PixelOp::Shadow && pixelOp != VDP1PixelOp::MSBOn;
+            constexpr bool mesh = index & 1;
+            return &SoftwareVDPRenderer::VDP1PlotTexturedLine<deinterlace, transparentMeshes, colorMode, pixelOp,
+                                                              gouraud, mesh>;
+        };
+        return std::array<FnVDP1PlotTexturedLine, sizeof...(indices)>{kernel.template operator()<indices>()...};
+    }(std::make_index_sequence<8 * kNumPixelOps * 4>{});
+
+    const size_t pixelOpIndex = static_cast<size_t>(VDP1GetPixelOp(mode)) - 1;
+    return kKernels[(mode.colorMode * kNumPixelOps + pixelOpIndex) * 4 + mode.gouraudEnable * 2 + mode.meshEnable];
+}
+
 template <bool deinterlace, bool transparentMeshes>
 FORCE_INLINE void SoftwareVDPRenderer::VDP1PlotTexturedQuad(uint32 cmdAddress, VDP1Command::Control control,
                                                             VDP1Command::Size size, CoordS32 coordA, CoordS32 coordB,
@@ -1439,6 +1618,11 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP1PlotTexturedQuad(uint32 cmdAddress, V
     case 5: break;                                 // 16 bpp, 32768 colors, RGB mode
     }
 
+    const FnVDP1PlotTexturedLine fnPlotTexturedLine =
+        fastPaths.vdp1LineKernels ? VDP1SelectTexturedLineKernel<deinterlace, transparentMeshes>(mode)
+                                  : &SoftwareVDPRenderer::VDP1PlotTexturedLine<deinterlace, transparentMeshes, 0,
+                                                                               VDP1PixelOp::Dynamic, false, false>;
+
     QuadStepper quad{coordA, coordB, coordC, coordD};
 
     if (mode.gouraudEnable) {
@@ -1509,7 +1693,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP1PlotTexturedQuad(uint32 cmdAddress, V
             lineParams.gouraudRight = &quad.RightEdge().Gouraud();
         }
 
-        if (VDP1PlotTexturedLine<deinterlace, transparentMeshes>(coordL, coordR, lineParams, regs1, doubleDensity)) {
+        if ((this->*fnPlotTexturedLine)(coordL, coordR, lineParams, regs1, doubleDensity)) {
             if (!linePlotted) {
                 linePlotted = true;
                 ++plottedSegmentsCount;
@@ -1523,6 +1707,213 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP1PlotTexturedQuad(uint32 cmdAddress, V
     }
 }
 
+template <bool transparentMeshes>
+bool SoftwareVDPRenderer::VDP1BlitNormalSprite(uint32 cmdAddress, VDP1Command::Control control,
+                                               VDP1Command::Size size, sint32 x, sint32 y) {
+    const VDP1Regs &regs1 = VDP1GetRegs();
+    const VDP2Regs &regs2 = VDP2GetRegs();
+    if (regs1.dblInterlaceEnable || regs2.TVMD.LSMDn == InterlaceMode::DoubleDensity) {
+        return false;
+    }
+
+    const VDP1Command::DrawMode mode{.u16 = VDP1ReadRendererVRAM<uint16>(cmdAddress + 0x04)};
+    if (mode.colorMode > 5 || mode.gouraudEnable || mode.meshEnable) {
+        return false;
+    }
+
+    const uint32 width = size.H * 8;
+    const uint32 height = size.V;
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    // Every pixel must pass the clipping tests
+    const auto &ctx = m_state.state1;
+    const sint32 x1 = x + static_cast<sint32>(width) - 1;
+    const sint32 y1 = y + static_cast<sint32>(height) - 1;
+    if (x < 0 || y < 0 || x1 > ctx.sysClipH || y1 > ctx.sysClipV) {
+        return false;
+    }
+    if (mode.userClippingEnable) {
+        const bool inside =
+            x >= ctx.userClipX0 && x1 <= ctx.userClipX1 && y >= ctx.userClipY0 && y1 <= ctx.userClipY1;
+        const bool outside = x1 < ctx.userClipX0 || x > ctx.userClipX1 || y1 < ctx.userClipY0 || y > ctx.userClipY1;
+        if (mode.clippingMode ? !outside : !inside) {
+            return false;
+        }
+    }
+
+    const uint16 color = VDP1ReadRendererVRAM<uint16>(cmdAddress + 0x06);
+    uint32 charAddr = VDP1ReadRendererVRAM<uint16>(cmdAddress + 0x08) * 8u;
+    const uint32 colorMode = mode.colorMode;
+
+    // Bank modes merge the texel into the color bank; the lookup table mode reads all 16 colors up front
+    static constexpr std::array<uint8, 5> kTexelMasks{0x0F, 0x0F, 0x3F, 0x7F, 0xFF};
+    uint16 colorBank = 0;
+    std::array<uint16, 16> lut;
+    switch (colorMode) {
+    case 0: colorBank = color & 0xFFF0; break; // 4 bpp, 16 colors, bank mode
+    case 1:                                    // 4 bpp, 16 colors, lookup table mode
+        for (uint32 i = 0; i < lut.size(); i++) {
+            lut[i] = VDP1ReadRendererVRAM<uint16>(i * sizeof(uint16) + (static_cast<uint32>(color) << 3u));
+        }
+        break;
+    case 2: colorBank = color & 0xFFC0; break; // 8 bpp, 64 colors, bank mode
+    case 3: colorBank = color & 0xFF80; break; // 8 bpp, 128 colors, bank mode
+    case 4: colorBank = color & 0xFF00; break; // 8 bpp, 256 colors, bank mode
+    case 5: charAddr &= ~0xF; break;           // 16 bpp, 32768 colors, RGB mode
+    }
+
+    auto &vram = VDP1GetRendererVRAM();
+    auto readVRAM = [&](uint32 address, uint8 *out, uint32 count) {
+        address &= kVDP1VRAMSize - 1;
+        if (address + count <= kVDP1VRAMSize) {
+            std::copy_n(&vram[address], count, out);
+        } else {
+            for (uint32 i = 0; i < count; i++) {
+                out[i] = vram[(address + i) & (kVDP1VRAMSize - 1)];
+            }
+        }
+    };
+
+    static constexpr uint32 kMaxWidth = 63 * 8;
+    alignas(16) std::array<uint8, kMaxWidth * sizeof(uint16)> raw;
+    alignas(16) std::array<uint8, kMaxWidth> texels;
+    alignas(16) std::array<uint16, kMaxWidth> colors;
+    alignas(16) std::array<uint8, kMaxWidth> opaque;
+
+    const auto fbIndex = VDP1GetDisplayFBIndex() ^ 1;
+    auto &drawFB = VDP1GetRendererDrawFB(false)[fbIndex];
+    auto &meshFB = m_meshFB[false][fbIndex];
+    const VDP1PixelOp op = VDP1GetPixelOp(mode);
+
+    // Transparent pixels count as plotted unless the clipping mode is set, in which case VDP1PlotTexturedQuad stops
+    // drawing the sprite when a line has no visible pixels. Follow the same rules to produce identical results.
+    const CoordS32 coordA{x, y};
+    const CoordS32 coordB{x1, y};
+    const CoordS32 coordC{x1, y1};
+    const CoordS32 coordD{x, y1};
+    const int plottedSegmentsMax = QuadStepper{coordA, coordB, coordC, coordD}.IsDegenerate() ? 2 : 1;
+    int plottedSegmentsCount = 0;
+    bool linePlotted = false;
+
+    for (uint32 row = 0; row < height; row++) {
+        const uint32 v = control.flipV ? height - 1 - row : row;
+
+        // Decode the row in drawing order, cutting it short at the second end code
+        uint32 count = width;
+        if (colorMode == 5) {
+            readVRAM(charAddr + v * width * sizeof(uint16), raw.data(), width * sizeof(uint16));
+            for (uint32 i = 0; i < width; i++) {
+                colors[i] = util::ReadBE<uint16>(&raw[i * sizeof(uint16)]);
+            }
+            if (control.flipH) {
+                std::reverse(colors.begin(), colors.begin() + width);
+            }
+            bool hasEndCode = false;
+            for (uint32 i = 0; i < width; i++) {
+                const bool endCode = !mode.endCodeDisable && colors[i] == 0x7FFF;
+                if (endCode && hasEndCode) {
+                    count = i;
+                    break;
+                }
+                hasEndCode |= endCode;
+                const bool transparent = !bit::test<15>(colors[i]) && !mode.transparentPixelDisable;
+                opaque[i] = endCode || transparent ? 0x00 : 0xFF;
+            }
+        } else {
+            if (colorMode <= 1) {
+                readVRAM(charAddr + ((v * width) >> 1u), raw.data(), width / 2);
+                VDP1ExpandNibbles(raw.data(), texels.data(), width / 2);
+            } else {
+                readVRAM(charAddr + v * width, texels.data(), width);
+            }
+            if (control.flipH) {
+                std::reverse(texels.begin(), texels.begin() + width);
+            }
+
+            uint32 endCodePos = width;
+            if (!mode.endCodeDisable) {
+                const uint8 endCode = colorMode <= 1 ? 0xF : 0xFF;
+                endCodePos = VDP1FindTexel({texels.data(), width}, endCode);
+                if (endCodePos < width) {
+                    const uint32 next = endCodePos + 1;
+                    count = next + VDP1FindTexel({texels.data() + next, width - next}, endCode);
+                }
+            }
+
+            if (colorMode == 1) {
+                for (uint32 i = 0; i < count; i++) {
+                    colors[i] = lut[texels[i]];
+                    opaque[i] = texels[i] != 0 || mode.transparentPixelDisable ? 0xFF : 0x00;
+                }
+            } else {
+                VDP1ExpandBankTexels(texels.data(), colors.data(), opaque.data(), count, kTexelMasks[colorMode],
+                                     colorBank, mode.transparentPixelDisable);
+            }
+            if (endCodePos < count) {
+                opaque[endCodePos] = 0x00;
+            }
+        }
+
+        if (mode.clippingMode) {
+            const bool anyOpaque = std::any_of(opaque.begin(), opaque.begin() + count, [](uint8 o) { return o != 0; });
+            if (anyOpaque) {
+                if (!linePlotted) {
+                    linePlotted = true;
+                    ++plottedSegmentsCount;
+                }
+            } else if (plottedSegmentsCount >= plottedSegmentsMax) {
+                break;
+            } else {
+                linePlotted = false;
+            }
+        }
+
+        const uint32 fbRow = (y + row) * regs1.fbSizeH + x;
+        if (regs1.pixel8Bits) {
+            for (uint32 i = 0; i < count; i++) {
+                if (!opaque[i]) {
+                    continue;
+                }
+                const uint32 fbOffset = (fbRow + i) & 0x3FFFF;
+                if (op == VDP1PixelOp::MSBOn) {
+                    drawFB[fbOffset] |= 0x80;
+                } else {
+                    drawFB[fbOffset] = colors[i];
+                    if constexpr (transparentMeshes) {
+                        meshFB[fbOffset] = 0;
+                    }
+                }
+            }
+        } else if (op == VDP1PixelOp::Replace && (fbRow + count) * sizeof(uint16) <= kVDP1FBRAMSize) {
+            const uint32 fbOffset = fbRow * sizeof(uint16);
+            VDP1BlitReplaceRow(colors.data(), opaque.data(), &drawFB[fbOffset],
+                               transparentMeshes ? &meshFB[fbOffset] : nullptr, count);
+        } else {
+            for (uint32 i = 0; i < count; i++) {
+                if (!opaque[i]) {
+                    continue;
+                }
+                const uint32 fbOffset = ((fbRow + i) * sizeof(uint16)) & 0x3FFFE;
+                uint8 *pixel = &drawFB[fbOffset];
+                if (op == VDP1PixelOp::MSBOn) {
+                    *pixel |= 0x80;
+                } else {
+                    const Color555 srcColor{.u16 = colors[i]};
+                    const Color555 dstColor{.u16 = util::ReadBE<uint16>(pixel)};
+                    util::WriteBE<uint16>(pixel, VDP1CalcPixelColor(op, srcColor, dstColor).u16);
+                    if constexpr (transparentMeshes) {
+                        util::WriteBE<uint16>(&meshFB[fbOffset], 0);
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 template <bool deinterlace, bool transparentMeshes>
 FORCE_INLINE void SoftwareVDPRenderer::VDP1Cmd_Handle(uint32 cmdAddress, VDP1Command::Control control) {
     using enum VDP1Command::CommandType;
@@ -1575,6 +1966,10 @@ void SoftwareVDPRenderer::VDP1Cmd_DrawNormalSprite(uint32 cmdAddress, VDP1Comman
     devlog::trace<grp::swvdp1_cmd>("[{:05X}] Draw normal sprite: {:3d}x{:<3d} {:3d}x{:<3d} {:3d}x{:<3d} {:3d}x{:<3d}",
                                    cmdAddress, xa, ya, xb, ya, xb, yb, xa, yb);
 
+    if (fastPaths.vdp1SpriteBlit && VDP1BlitNormalSprite<transparentMeshes>(cmdAddress, control, size, xa, ya)) {
+        return;
+    }
+
     VDP1PlotTexturedQuad<deinterlace, transparentMeshes>(cmdAddress, control, size, coordA, coordB, coordC, coordD);
 }
 
@@ -2085,11 +2480,125 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2UpdateLineScreenScroll(uint32 y, cons
     bgState.lineScrollTableAddress = address;
 }
 
+// Computes rotation screen coordinates for a run of dots: (((k * scr) >> 16) + P) >> 10 per axis, stepping the screen
+// coordinates by inc every dot. The scaling coefficients (kx, ky) and viewpoint X (Xp) are taken per dot from coeffs
+// when the corresponding template flag is set, with coefficients converted to viewpoints by shifting left by 2.
+// The whole run goes through the scalar loop unless vectorize is set.
+template <bool perDotKx, bool perDotKy, bool perDotXp>
+FORCE_INLINE static void VDP2CalcRotationScreenCoords(std::span<CoordS32> out, sint32 scrX, sint32 scrY, sint32 incX,
+                                                      sint32 incY, sint32 kx, sint32 ky, sint32 Xp, sint32 Yp,
+                                                      const sint32 *coeffs, bool vectorize) {
+    size_t i = 0;
+
+    // The 64-bit sum fits the result in bits 26 to 57, so a logical shift yields the same low 32 bits as the scalar
+    // arithmetic shift
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__AVX2__)
+    // Two dots at a time, one 64-bit lane per coordinate
+    const __m256i packLow = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    const __m128i scrInc = _mm_setr_epi32(incX * 2, incY * 2, incX * 2, incY * 2);
+    __m128i scr = _mm_setr_epi32(scrX, scrY, scrX + incX, scrY + incY);
+    for (; vectorize && i + 2 <= out.size(); i += 2) {
+        const sint32 c0 = perDotKx || perDotKy || perDotXp ? coeffs[i + 0] : 0;
+        const sint32 c1 = perDotKx || perDotKy || perDotXp ? coeffs[i + 1] : 0;
+        const __m256i k = _mm256_cvtepi32_epi64(
+            _mm_setr_epi32(perDotKx ? c0 : kx, perDotKy ? c0 : ky, perDotKx ? c1 : kx, perDotKy ? c1 : ky));
+        const __m256i p = _mm256_slli_epi64(
+            _mm256_cvtepi32_epi64(_mm_setr_epi32(perDotXp ? c0 << 2 : Xp, Yp, perDotXp ? c1 << 2 : Xp, Yp)), 16);
+
+        const __m256i sum = _mm256_add_epi64(_mm256_mul_epi32(k, _mm256_cvtepi32_epi64(scr)), p);
+        const __m256i coords = _mm256_permutevar8x32_epi32(_mm256_srli_epi64(sum, 26), packLow);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&out[i]), _mm256_castsi256_si128(coords));
+
+        scr = _mm_add_epi32(scr, scrInc);
+    }
+    scrX = _mm_cvtsi128_si32(scr);
+    scrY = _mm_extract_epi32(scr, 1);
+    #endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    // Two dots at a time
+    const sint32 scrIncLanes[4] = {incX * 2, incY * 2, incX * 2, incY * 2};
+    const sint32 scrLanes[4] = {scrX, scrY, scrX + incX, scrY + incY};
+    const int32x4_t scrInc = vld1q_s32(scrIncLanes);
+    int32x4_t scr = vld1q_s32(scrLanes);
+    for (; vectorize && i + 2 <= out.size(); i += 2) {
+        const sint32 c0 = perDotKx || perDotKy || perDotXp ? coeffs[i + 0] : 0;
+        const sint32 c1 = perDotKx || perDotKy || perDotXp ? coeffs[i + 1] : 0;
+        const sint32 kLanes[4] = {perDotKx ? c0 : kx, perDotKy ? c0 : ky, perDotKx ? c1 : kx, perDotKy ? c1 : ky};
+        const sint32 pLanes[4] = {perDotXp ? c0 << 2 : Xp, Yp, perDotXp ? c1 << 2 : Xp, Yp};
+        const int32x4_t k = vld1q_s32(kLanes);
+        const int32x4_t p = vld1q_s32(pLanes);
+
+        const int64x2_t prod0 = vmull_s32(vget_low_s32(k), vget_low_s32(scr));
+        const int64x2_t prod1 = vmull_high_s32(k, scr);
+        const int64x2_t sum0 = vaddq_s64(prod0, vshll_n_s32(vget_low_s32(p), 16));
+        const int64x2_t sum1 = vaddq_s64(prod1, vshll_high_n_s32(p, 16));
+        const int32x4_t coords = vcombine_s32(vmovn_s64(vshrq_n_s64(sum0, 26)), vmovn_s64(vshrq_n_s64(sum1, 26)));
+        vst1q_s32(&out[i].x(), coords);
+
+        scr = vaddq_s32(scr, scrInc);
+    }
+    scrX = vgetq_lane_s32(scr, 0);
+    scrY = vgetq_lane_s32(scr, 1);
+#endif
+
+    for (; i < out.size(); i++) {
+        const sint64 dotKx = perDotKx ? coeffs[i] : kx;
+        const sint64 dotKy = perDotKy ? coeffs[i] : ky;
+        const sint32 dotXp = perDotXp ? coeffs[i] << 2 : Xp;
+        out[i].x() = (((dotKx * scrX) >> 16) + dotXp) >> 10;
+        out[i].y() = (((dotKy * scrY) >> 16) + Yp) >> 10;
+        scrX += incX;
+        scrY += incY;
+    }
+}
+
+// Computes rotated sprite coordinates for a run of dots, stepping by inc every dot. The whole run goes through the
+// scalar loop unless vectorize is set.
+FORCE_INLINE static void VDP2CalcRotationSpriteCoords(std::span<CoordS32> out, sint32 sprX, sint32 sprY, sint32 incX,
+                                                      sint32 incY, bool vectorize) {
+    size_t i = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #if defined(__SSE2__)
+    // Two dots at a time
+    const __m128i sprInc = _mm_setr_epi32(incX * 2, incY * 2, incX * 2, incY * 2);
+    __m128i spr = _mm_setr_epi32(sprX, sprY, sprX + incX, sprY + incY);
+    for (; vectorize && i + 2 <= out.size(); i += 2) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(&out[i]), _mm_srai_epi32(spr, 10));
+        spr = _mm_add_epi32(spr, sprInc);
+    }
+    sprX = _mm_cvtsi128_si32(spr);
+    sprY = _mm_cvtsi128_si32(_mm_shuffle_epi32(spr, 0b01));
+    #endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+    // Two dots at a time
+    const sint32 sprIncLanes[4] = {incX * 2, incY * 2, incX * 2, incY * 2};
+    const sint32 sprLanes[4] = {sprX, sprY, sprX + incX, sprY + incY};
+    const int32x4_t sprInc = vld1q_s32(sprIncLanes);
+    int32x4_t spr = vld1q_s32(sprLanes);
+    for (; vectorize && i + 2 <= out.size(); i += 2) {
+        vst1q_s32(&out[i].x(), vshrq_n_s32(spr, 10));
+        spr = vaddq_s32(spr, sprInc);
+    }
+    sprX = vgetq_lane_s32(spr, 0);
+    sprY = vgetq_lane_s32(spr, 1);
+#endif
+
+    for (; i < out.size(); i++) {
+        out[i].x() = sprX >> 10;
+        out[i].y() = sprY >> 10;
+        sprX += incX;
+        sprY += incY;
+    }
+}
+
 FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcRotationParameterTables(uint32 y, VDP2Regs &regs2) {
     VDP1Regs &regs1 = VDP1GetRegs();
 
     const uint32 baseAddress = regs2.commonRotParams.baseAddress & 0xFFF7C; // mask bit 6 (shifted left by 1)
     const bool readAll = y == 0;
+    const bool vectorize = fastPaths.vdp2RotationSIMD;
     const auto &vram2 = VDP2GetVRAM();
 
     for (int i = 0; i < 2; i++) {
@@ -2154,8 +2663,8 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcRotationParameterTables(uint32 y,
         const sint32 scrYIncH = (t.D * t.deltaX + t.E * t.deltaY) >> 10;
 
         // Scaling factors (8.16)
-        sint64 kx = t.kx;
-        sint64 ky = t.ky;
+        sint32 kx = t.kx;
+        sint32 ky = t.ky;
 
         // Current screen coordinates (18.10)
         sint32 scrX = Xsp;
@@ -2183,21 +2692,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcRotationParameterTables(uint32 y,
             coeff = VDP2FetchRotationCoefficient(regs2, params, KA);
         }
 
-        auto writeScreenCoord = [&](uint32 x) {
-            // Resulting screen coordinates (26.0)
-            // (16*10) + 10 = 26 + 10 frac bits
-            // (24*28) + 28 = 52 + 28 total bits
-            // reduce 26 to 10 frac bits
-            // = 10 + 10 = 10 frac bits
-            // = 36 + 28 = 36 total bits
-            // remove frac bits from result = 26 total bits
-            lineOut.screenCoords[x].x() = (((kx * scrX) >> 16) + Xp) >> 10;
-            lineOut.screenCoords[x].y() = (((ky * scrY) >> 16) + Yp) >> 10;
-
-            // Increment screen coordinates and coefficient table address by Hcnt
-            scrX += scrXIncH;
-            scrY += scrYIncH;
-        };
+        const std::span<CoordS32> screenCoords = std::span{lineOut.screenCoords}.first(maxX);
 
         // Precompute whole line of screen coordinates
         if (params.coeffTableEnable && perDotCoeff) {
@@ -2224,28 +2719,20 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcRotationParameterTables(uint32 y,
             using enum CoefficientDataMode;
             switch (params.coeffDataMode) {
             case ScaleCoeffXY:
-                for (uint32 x = 0; x < maxX; x++) {
-                    kx = ky = coeffValues[x];
-                    writeScreenCoord(x);
-                }
+                VDP2CalcRotationScreenCoords<true, true, false>(screenCoords, scrX, scrY, scrXIncH, scrYIncH, kx, ky,
+                                                                Xp, Yp, coeffValues.data(), vectorize);
                 break;
             case ScaleCoeffX:
-                for (uint32 x = 0; x < maxX; x++) {
-                    kx = coeffValues[x];
-                    writeScreenCoord(x);
-                }
+                VDP2CalcRotationScreenCoords<true, false, false>(screenCoords, scrX, scrY, scrXIncH, scrYIncH, kx, ky,
+                                                                 Xp, Yp, coeffValues.data(), vectorize);
                 break;
             case ScaleCoeffY:
-                for (uint32 x = 0; x < maxX; x++) {
-                    ky = coeffValues[x];
-                    writeScreenCoord(x);
-                }
+                VDP2CalcRotationScreenCoords<false, true, false>(screenCoords, scrX, scrY, scrXIncH, scrYIncH, kx, ky,
+                                                                 Xp, Yp, coeffValues.data(), vectorize);
                 break;
             case ViewpointX:
-                for (uint32 x = 0; x < maxX; x++) {
-                    Xp = coeffValues[x] << 2;
-                    writeScreenCoord(x);
-                }
+                VDP2CalcRotationScreenCoords<false, false, true>(screenCoords, scrX, scrY, scrXIncH, scrYIncH, kx, ky,
+                                                                 Xp, Yp, coeffValues.data(), vectorize);
                 break;
             }
         } else {
@@ -2268,26 +2755,19 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcRotationParameterTables(uint32 y,
                 }
             }
 
-            for (uint32 x = 0; x < maxX; x++) {
-                writeScreenCoord(x);
-            }
+            VDP2CalcRotationScreenCoords<false, false, false>(screenCoords, scrX, scrY, scrXIncH, scrYIncH, kx, ky, Xp,
+                                                              Yp, nullptr, vectorize);
         }
 
         // Precompute whole line of sprite coordinates
         if (regs1.fbRotEnable && i == 0) {
             // Current sprite coordinates (13.10)
-            sint32 sprX = t.Xst + y * t.deltaXst;
-            sint32 sprY = t.Yst + y * t.deltaYst;
+            const sint32 sprX = t.Xst + y * t.deltaXst;
+            const sint32 sprY = t.Yst + y * t.deltaYst;
 
-            for (uint32 x = 0; x < maxX; x++) {
-                // Resulting sprite coordinates (13.0)
-                lineOut.spriteCoords[x].x() = sprX >> 10ll;
-                lineOut.spriteCoords[x].y() = sprY >> 10ll;
-
-                // Increment sprite coordinates by Hcnt
-                sprX += t.deltaX;
-                sprY += t.deltaY;
-            }
+            // Resulting sprite coordinates (13.0), incremented by Hcnt
+            VDP2CalcRotationSpriteCoords(std::span{lineOut.spriteCoords}.first(maxX), sprX, sprY, t.deltaX, t.deltaY,
+                                         vectorize);
         }
     }
 }
@@ -2301,25 +2781,37 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindows(uint32 y, const VDP2Regs
         auto &bgParams = regs2.bgParams[i];
         auto &bgWindow = m_bgWindows[altField][i];
 
-        VDP2CalcWindow<altField>(y, regs2, bgParams.windowSet, std::span{bgWindow}.first(m_HRes));
+        VDP2CalcWindow<altField>(y, regs2, bgParams.windowSet, bgWindow);
     }
 
     // Calculate window for rotation parameters
-    VDP2CalcWindow<altField>(y, regs2, regs2.commonRotParams.windowSet,
-                             std::span{m_rotParamsWindow[altField]}.first(m_HRes));
+    VDP2CalcWindow<altField>(y, regs2, regs2.commonRotParams.windowSet, m_rotParamsWindow[altField]);
 
     // Calculate window for color calculations
-    VDP2CalcWindow<altField>(y, regs2, regs2.colorCalcParams.windowSet,
-                             std::span{m_colorCalcWindow[altField]}.first(m_HRes));
+    VDP2CalcWindow<altField>(y, regs2, regs2.colorCalcParams.windowSet, m_colorCalcWindow[altField]);
 }
 
 template <bool altField, bool hasSpriteWindow>
 FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindow(uint32 y, const VDP2Regs &regs2,
                                                       const WindowSet<hasSpriteWindow> &windowSet,
-                                                      std::span<bool> windowState) {
+                                                      PixelMask &windowState) {
     // If no windows are enabled, consider the pixel outside of windows
     if (!std::any_of(windowSet.enabled.begin(), windowSet.enabled.end(), std::identity{})) {
-        std::fill(windowState.begin(), windowState.end(), false);
+        windowState.Fill(false);
+        return;
+    }
+
+    if (!fastPaths.vdp2WindowMasks) {
+        std::array<bool, kMaxResH> windowPixels;
+        if (windowSet.logic == WindowLogic::And) {
+            VDP2CalcWindowLogic<altField, false>(y, regs2, windowSet, windowPixels);
+        } else {
+            VDP2CalcWindowLogic<altField, true>(y, regs2, windowSet, windowPixels);
+        }
+        windowState.Fill(false);
+        for (uint32 x = 0; x < m_HRes; x++) {
+            windowState.Set(x, windowPixels[x]);
+        }
         return;
     }
 
@@ -2330,12 +2822,33 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindow(uint32 y, const VDP2Regs &
     }
 }
 
-template <bool altField, bool logicOR, bool hasSpriteWindow>
+template <bool altField, bool logicOR, bool hasSpriteWindow, typename WindowState>
 FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindowLogic(uint32 y, const VDP2Regs &regs2,
                                                            const WindowSet<hasSpriteWindow> &windowSet,
-                                                           std::span<bool> windowState) {
-    // Initialize to all inside if using AND logic or all outside if using OR logic
-    std::fill(windowState.begin(), windowState.end(), !logicOR);
+                                                           WindowState &windowState) {
+    static constexpr bool kPerPixel = std::is_same_v<WindowState, std::array<bool, kMaxResH>>;
+    const sint16 width = m_HRes;
+
+    auto fill = [&](bool value) {
+        if constexpr (kPerPixel) {
+            std::fill_n(windowState.begin(), width, value);
+        } else {
+            windowState.Fill(value);
+        }
+    };
+
+    // Each window's inside area is ANDed into the state when using AND logic or ORed into it when using OR logic, so
+    // initialize to all inside if using AND logic or all outside if using OR logic
+    fill(!logicOR);
+
+    // Combines one word of a mask
+    auto combine = [&](auto &mask, uint32 index, uint64 bits) {
+        if constexpr (logicOR) {
+            mask.words[index] |= bits;
+        } else {
+            mask.words[index] &= bits;
+        }
+    };
 
     const uint16 doubleV = regs2.TVMD.LSMDn == InterlaceMode::SingleDensity;
 
@@ -2371,7 +2884,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindowLogic(uint32 y, const VDP2R
         if (sy < startY || sy > endY) {
             if (logicOR == inverted) {
                 // Cases 1 and 4
-                std::fill(windowState.begin(), windowState.end(), logicOR);
+                fill(logicOR);
                 return;
             } else {
                 // Cases 2 and 3
@@ -2419,22 +2932,30 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindowLogic(uint32 y, const VDP2R
             endX >>= 1;
         }
 
-        // Fill in horizontal coordinate
-        if (inverted != logicOR) {
-            // - fill [startX..endX] with outside if using AND logic and inverted
-            // - fill [startX..endX] with inside if using OR logic and not inverted
-            if (startX < windowState.size()) {
-                endX = std::min<sint16>(endX, windowState.size() - 1);
-                if (startX <= endX) {
-                    std::fill(windowState.begin() + startX, windowState.begin() + endX + 1, logicOR);
+        if constexpr (kPerPixel) {
+            // Fill in horizontal coordinate
+            if (inverted != logicOR) {
+                // - fill [startX..endX] with outside if using AND logic and inverted
+                // - fill [startX..endX] with inside if using OR logic and not inverted
+                if (startX < width) {
+                    endX = std::min<sint16>(endX, width - 1);
+                    if (startX <= endX) {
+                        std::fill(windowState.begin() + startX, windowState.begin() + endX + 1, logicOR);
+                    }
+                }
+            } else {
+                // Fill complement of [startX..endX] with outside if using AND logic or inside if using OR logic
+                startX = std::min<sint16>(startX, width);
+                std::fill_n(windowState.begin(), startX, logicOR);
+                if (endX < width) {
+                    std::fill(windowState.begin() + endX + 1, windowState.begin() + width, logicOR);
                 }
             }
         } else {
-            // Fill complement of [startX..endX] with outside if using AND logic or inside if using OR logic
-            startX = std::min<sint16>(startX, windowState.size());
-            std::fill_n(windowState.begin(), startX, logicOR);
-            if (endX < windowState.size()) {
-                std::fill(windowState.begin() + endX + 1, windowState.end(), logicOR);
+            // Combine horizontal coordinate; the window covers [startX..endX], or its complement if inverted
+            const uint64 invertMask = inverted ? ~0ull : 0ull;
+            for (uint32 i = 0; i < PixelMask::kNumWords; i++) {
+                combine(windowState, i, PixelMask::RangeBits(i, startX, endX + 1) ^ invertMask);
             }
         }
     }
@@ -2443,11 +2964,19 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2CalcWindowLogic(uint32 y, const VDP2R
     if constexpr (hasSpriteWindow) {
         if (windowSet.enabled[2]) {
             const bool inverted = windowSet.inverted[2];
-            for (uint32 x = 0; x < m_HRes; x++) {
-                if constexpr (logicOR) {
-                    windowState[x] |= m_spriteLayerAttrs[altField].shadowOrWindow[x] != inverted;
-                } else {
-                    windowState[x] &= m_spriteLayerAttrs[altField].shadowOrWindow[x] != inverted;
+            const auto &shadowOrWindow = m_spriteLayerAttrs[altField].shadowOrWindow;
+            if constexpr (kPerPixel) {
+                for (uint32 x = 0; x < m_HRes; x++) {
+                    if constexpr (logicOR) {
+                        windowState[x] |= shadowOrWindow[x] != inverted;
+                    } else {
+                        windowState[x] &= shadowOrWindow[x] != inverted;
+                    }
+                }
+            } else {
+                const uint64 invertMask = inverted ? ~0ull : 0ull;
+                for (uint32 i = 0; i < PixelMask::kNumWords; i++) {
+                    combine(windowState, i, shadowOrWindow.words[i] ^ invertMask);
                 }
             }
         }
@@ -2542,12 +3071,10 @@ void SoftwareVDPRenderer::VDP2DrawLine(uint32 y, bool altField) {
     // Calculate window for sprite layer
     if (altField) {
         VDP2CalcWindow<true>(VDP2GetY<deinterlace>(y, regs2) ^ static_cast<uint32>(altField), regs2,
-                             regs2.spriteParams.windowSet,
-                             std::span{m_spriteLayerAttrs[altField].window}.first(m_HRes));
+                             regs2.spriteParams.windowSet, m_spriteLayerAttrs[altField].window);
     } else {
         VDP2CalcWindow<false>(VDP2GetY<deinterlace>(y, regs2) ^ static_cast<uint32>(altField), regs2,
-                              regs2.spriteParams.windowSet,
-                              std::span{m_spriteLayerAttrs[altField].window}.first(m_HRes));
+                              regs2.spriteParams.windowSet, m_spriteLayerAttrs[altField].window);
     }
 
     // Draw sprite layer
@@ -2638,7 +3165,7 @@ NO_INLINE void SoftwareVDPRenderer::VDP2DrawSpriteLayer(uint32 y, const VDP2Regs
             const auto &coord = rotParamOut.spriteCoords[x];
             if (coord.x() < 0 || coord.x() >= regs1.fbSizeH || coord.y() < 0 || coord.y() >= regs1.fbSizeV) {
                 layerOut.pixels.priority[xx] = 0;
-                layerAttrs.shadowOrWindow[xx] = false;
+                layerAttrs.shadowOrWindow.Set(xx, false);
                 layerAttrs.specialType[xx] = SpriteData::Special::Transparent;
                 if (doubleResH) {
                     layerOut.pixels.CopyPixel(xx, xx + 1);
@@ -2646,7 +3173,7 @@ NO_INLINE void SoftwareVDPRenderer::VDP2DrawSpriteLayer(uint32 y, const VDP2Regs
                 }
                 if constexpr (transparentMeshes) {
                     meshLayerOut.pixels.priority[xx] = 0;
-                    meshLayerAttrs.shadowOrWindow[xx] = false;
+                    meshLayerAttrs.shadowOrWindow.Set(xx, false);
                     layerAttrs.specialType[xx] = SpriteData::Special::Transparent;
                     if (doubleResH) {
                         meshLayerOut.pixels.CopyPixel(xx, xx + 1);
@@ -2696,7 +3223,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawSpritePixel(uint32 x, const VDP2R
     // NOTE: intentionally using the base sprite layer here as the windows are not computed for the mesh layer
     if (m_spriteLayerAttrs[altField].window[x]) {
         layerOut.pixels.priority[x] = 0;
-        layerAttrs.shadowOrWindow[x] = false;
+        layerAttrs.shadowOrWindow.Set(x, false);
         layerAttrs.specialType[x] = SpriteData::Special::Transparent;
         return;
     }
@@ -2713,14 +3240,14 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawSpritePixel(uint32 x, const VDP2R
             if (params.type >= 8) {
                 if (bit::extract<0, 7>(spriteDataValue) == 0) {
                     layerOut.pixels.priority[x] = 0;
-                    layerAttrs.shadowOrWindow[x] = false;
+                    layerAttrs.shadowOrWindow.Set(x, false);
                     layerAttrs.specialType[x] = SpriteData::Special::Transparent;
                     return;
                 }
             } else if (params.type >= 2) {
                 if (params.useSpriteWindow && bit::extract<0, 14>(spriteDataValue) == 0) {
                     layerOut.pixels.priority[x] = 0;
-                    layerAttrs.shadowOrWindow[x] = false;
+                    layerAttrs.shadowOrWindow.Set(x, false);
                     layerAttrs.specialType[x] = SpriteData::Special::Transparent;
                     return;
                 }
@@ -2728,10 +3255,10 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawSpritePixel(uint32 x, const VDP2R
 
             layerOut.pixels.color[x] = ConvertRGB555to888(Color555{spriteDataValue});
             layerOut.pixels.priority[x] = params.priorities[0];
-            layerOut.pixels.specialColorCalc[x] = false;
+            layerOut.pixels.specialColorCalc.Set(x, false);
 
             layerAttrs.colorCalcRatio[x] = params.colorCalcRatios[0];
-            layerAttrs.shadowOrWindow[x] = false;
+            layerAttrs.shadowOrWindow.Set(x, false);
             layerAttrs.specialType[x] = SpriteData::Special::Normal;
             return;
         }
@@ -2744,7 +3271,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawSpritePixel(uint32 x, const VDP2R
     if (params.useSpriteWindow && params.spriteWindowEnabled &&
         spriteData.shadowOrWindow != params.spriteWindowInverted) {
         layerOut.pixels.priority[x] = 0;
-        layerAttrs.shadowOrWindow[x] = true;
+        layerAttrs.shadowOrWindow.Set(x, true);
         layerAttrs.specialType[x] = SpriteData::Special::Transparent;
         return;
     }
@@ -2756,10 +3283,10 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawSpritePixel(uint32 x, const VDP2R
     layerOut.pixels.priority[x] = spriteData.special == SpriteData::Special::Transparent && !spriteData.shadowOrWindow
                                       ? 0
                                       : params.priorities[spriteData.priority];
-    layerOut.pixels.specialColorCalc[x] = true;
+    layerOut.pixels.specialColorCalc.Set(x, true);
 
     layerAttrs.colorCalcRatio[x] = params.colorCalcRatios[spriteData.colorCalcRatio];
-    layerAttrs.shadowOrWindow[x] = spriteData.shadowOrWindow;
+    layerAttrs.shadowOrWindow.Set(x, spriteData.shadowOrWindow);
     layerAttrs.specialType[x] = spriteData.special;
 }
 
@@ -2768,7 +3295,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawNormalBG(const VDP2Regs &regs2, u
     static_assert(bgIndex < 4, "Invalid NBG index");
 
     using FnDraw = void (SoftwareVDPRenderer::*)(const VDP2Regs &, const BGParams &, LayerOutput &,
-                                                 const NBGLayerState &, VRAMFetcher &, std::span<const bool>, bool);
+                                                 const NBGLayerState &, VRAMFetcher &, const PixelMask &, bool);
 
     // Lookup table of scroll BG drawing functions
     // Indexing: [charMode][fourCellChar][colorFormat][colorMode]
@@ -2830,7 +3357,7 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawNormalBG(const VDP2Regs &regs2, u
 
     LayerOutput &layerOut = m_layerOutputs[altField][bgIndex + 2];
     VRAMFetcher &vramFetcher = m_vramFetchers[altField][bgIndex];
-    auto windowState = std::span<const bool>{m_bgWindows[altField][bgIndex + 1]}.first(m_HRes);
+    const PixelMask &windowState = m_bgWindows[altField][bgIndex + 1];
 
     const uint32 cf = static_cast<uint32>(bgParams.colorFormat);
     if (bgParams.bitmap) {
@@ -2852,9 +3379,9 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawRotationBG(const VDP2Regs &regs2,
     static_assert(bgIndex < 2, "Invalid RBG index");
 
     using FnDrawScroll = void (SoftwareVDPRenderer::*)(const VDP2Regs &, const BGParams &, LayerOutput &, VRAMFetcher &,
-                                                       std::span<const bool>, bool);
+                                                       const PixelMask &, bool);
     using FnDrawBitmap =
-        void (SoftwareVDPRenderer::*)(const VDP2Regs &, const BGParams &, LayerOutput &, std::span<const bool>, bool);
+        void (SoftwareVDPRenderer::*)(const VDP2Regs &, const BGParams &, LayerOutput &, const PixelMask &, bool);
 
     // Lookup table of scroll BG drawing functions
     // Indexing: [charMode][fourCellChar][colorFormat][colorMode]
@@ -2907,7 +3434,13 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawRotationBG(const VDP2Regs &regs2,
     const BGParams &bgParams = regs2.bgParams[bgIndex];
     LayerOutput &layerOut = m_layerOutputs[altField][bgIndex + 1];
     VRAMFetcher &vramFetcher = m_vramFetchers[altField][bgIndex + 4];
-    auto windowState = std::span<const bool>{m_bgWindows[altField][bgIndex]}.first(m_HRes);
+    const PixelMask &windowState = m_bgWindows[altField][bgIndex];
+
+    // Nothing is fetched for pixels inside the window, so a fully windowed line is simply transparent
+    if (windowState.All(0, m_HRes)) {
+        std::fill_n(layerOut.pixels.priority.begin(), m_HRes, 0);
+        return;
+    }
 
     const uint32 cf = static_cast<uint32>(bgParams.colorFormat);
     if (bgParams.bitmap) {
@@ -4091,25 +4624,28 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2ComposeLine(uint32 y, const VDP2Regs
             const auto colorGradIndex = static_cast<size_t>(colorCalcParams.colorGradScreen);
             const LayerIndex colorGradLayer = kColorGradLayers[colorGradIndex];
 
-            // Compute color gradation
-            auto &mask = composeLineBuffers.colorGradEnabled;
-            for (uint32 x = 0; x < m_HRes; x++) {
-                mask[x] = scanline_layers[x][0] == colorGradLayer || scanline_layers[x][1] == colorGradLayer;
-            }
+            // Invalid screen selections have no layer to take the gradation from
+            if (colorGradLayer != LYR_Invalid) {
+                // Compute color gradation
+                auto &mask = composeLineBuffers.colorGradEnabled;
+                for (uint32 x = 0; x < m_HRes; x++) {
+                    mask[x] = scanline_layers[x][0] == colorGradLayer || scanline_layers[x][1] == colorGradLayer;
+                }
 
-            auto &input = m_layerOutputs[altField][colorGradLayer].pixels.color;
-            auto &output = composeLineBuffers.colorGradLayerColors;
+                auto &input = m_layerOutputs[altField][colorGradLayer].pixels.color;
+                auto &output = composeLineBuffers.colorGradLayerColors;
 
-            // TODO: should pixels 0 and 1 pull from pixels -1 and -2?
-            output[0] = input[0];
-            output[1] = AverageRGB888(input[0], input[1]);
-            Color888GradationMasked(std::span{output}.subspan(2, m_HRes - 2), std::span{mask}, std::span{input});
+                // TODO: should pixels 0 and 1 pull from pixels -1 and -2?
+                output[0] = input[0];
+                output[1] = AverageRGB888(input[0], input[1]);
+                Color888GradationMasked(std::span{output}.subspan(2, m_HRes - 2), std::span{mask}, std::span{input});
 
-            // Replace layer 1 with color gradation screen where layer 0 is also the color gradation layer
-            for (uint32 x = 0; x < m_HRes; x++) {
-                if (scanline_layers[x][0] == colorGradLayer) {
-                    scanline_layers[x][1] = colorGradLayer;
-                    layer1Pixels[x] = output[x];
+                // Replace layer 1 with color gradation screen where layer 0 is also the color gradation layer
+                for (uint32 x = 0; x < m_HRes; x++) {
+                    if (scanline_layers[x][0] == colorGradLayer) {
+                        scanline_layers[x][1] = colorGradLayer;
+                        layer1Pixels[x] = output[x];
+                    }
                 }
             }
         } else if (normalTVMode && colorCalcParams.extendedColorCalcEnable) {
@@ -4281,17 +4817,20 @@ FORCE_INLINE void SoftwareVDPRenderer::VDP2ComposeLine(uint32 y, const VDP2Regs
         if (overlay.type != OverlayType::None) {
             if (overlay.type == OverlayType::Windows && overlay.windowLayerIndex > 5) {
                 const auto &windowSet = overlay.customWindowSet;
-                auto &windowState = overlay.customWindowState[altField];
                 auto windowParams = regs2.windowParams;
                 for (uint32 i = 0; i < 2; ++i) {
                     windowParams[i].lineWindowTableEnable = overlay.customLineWindowTableEnable[i];
                     windowParams[i].lineWindowTableAddress = overlay.customLineWindowTableAddress[i] & 0x7FFFF;
                 }
+                PixelMask windowState;
                 if (altField) {
                     VDP2CalcWindow<true>(y, regs2, windowSet, windowState);
                 } else {
                     VDP2CalcWindow<false>(y, regs2, windowSet, windowState);
                 }
+                for (uint32 x = 0; x < m_HRes; ++x) {
+                    overlay.customWindowState[altField][x] = windowState[x];
+                }
             }
 
             for (uint32 x = 0; x < m_HRes; ++x) {
@@ -4411,7 +4950,7 @@ template <SoftwareVDPRenderer::CharacterMode charMode, bool fourCellChar, ColorF
           bool useVCellScroll, bool deinterlace>
 NO_INLINE void SoftwareVDPRenderer::VDP2DrawNormalScrollBG(const VDP2Regs &regs2, const BGParams &bgParams,
                                                            LayerOutput &layerOut, const NBGLayerState &bgState,
-                                                           VRAMFetcher &vramFetcher, std::span<const bool> windowState,
+                                                           VRAMFetcher &vramFetcher, const PixelMask &windowState,
                                                            bool altField) {
     const bool altLine = deinterlace && altField && regs2.TVMD.LSMDn == InterlaceMode::DoubleDensity;
     uint32 fracScrollX = bgState.fracScrollX + bgParams.scrollAmountH;
@@ -4441,50 +4980,57 @@ NO_INLINE void SoftwareVDPRenderer::VDP2DrawNormalScrollBG(const VDP2Regs &regs2
         vcellScrollY = readCellScrollY(true);
     }
 
-    for (uint32 x = 0; x < m_HRes; x++) {
-        // Apply horizontal mosaic or vertical cell-scrolling
-        // Mosaic takes priority
-        if (bgParams.mosaicEnable) {
-            // Apply horizontal mosaic
-            const uint8 currMosaicCounterX = mosaicCounterX;
-            mosaicCounterX++;
-            if (mosaicCounterX >= regs2.mosaicH) {
-                mosaicCounterX = 0;
-            }
-            if (currMosaicCounterX > 0) {
-                // Simply copy over the data from the previous pixel
-                layerOut.pixels.CopyPixel(x - 1, x);
+    // Unscaled and integer-scaled lines can be drawn a cell row at a time
+    if (fastPaths.vdp2ScrollSpans && !bgParams.mosaicEnable && !vcellScrollEnable &&
+        (bgState.scrollIncH & 0xFFu) == 0u && bgState.scrollIncH != 0u) {
+        VDP2DrawScrollBGSpans<charMode, fourCellChar, colorFormat, colorMode>(
+            regs2, bgParams, layerOut, vramFetcher, windowState, fracScrollX, bgState.scrollIncH, fracScrollY >> 8u);
+    } else {
+        for (uint32 x = 0; x < m_HRes; x++) {
+            // Apply horizontal mosaic or vertical cell-scrolling
+            // Mosaic takes priority
+            if (bgParams.mosaicEnable) {
+                // Apply horizontal mosaic
+                const uint8 currMosaicCounterX = mosaicCounterX;
+                mosaicCounterX++;
+                if (mosaicCounterX >= regs2.mosaicH) {
+                    mosaicCounterX = 0;
+                }
+                if (currMosaicCounterX > 0) {
+                    // Simply copy over the data from the previous pixel
+                    layerOut.pixels.CopyPixel(x - 1, x);
 
-                // Increment horizontal coordinate
-                fracScrollX += bgState.scrollIncH;
-                continue;
-            }
-        } else if (vcellScrollEnable) {
-            // Update vertical cell scroll amount
-            if ((fracScrollX >> (8u + 3u)) != vcellScrollX) {
-                vcellScrollX = fracScrollX >> (8u + 3u);
-                vcellScrollY = readCellScrollY();
+                    // Increment horizontal coordinate
+                    fracScrollX += bgState.scrollIncH;
+                    continue;
+                }
+            } else if (vcellScrollEnable) {
+                // Update vertical cell scroll amount
+                if ((fracScrollX >> (8u + 3u)) != vcellScrollX) {
+                    vcellScrollX = fracScrollX >> (8u + 3u);
+                    vcellScrollY = readCellScrollY();
+                }
             }
-        }
 
-        if (windowState[x]) {
-            // Make pixel transparent if inside active window area
-            layerOut.pixels.priority[x] = 0;
-        } else {
-            // Compute integer scroll screen coordinates
-            const uint32 scrollX = fracScrollX >> 8u;
-            const uint32 scrollY = (fracScrollY + vcellScrollY) >> 8u;
-            const CoordU32 scrollCoord{scrollX, scrollY};
+            if (windowState[x]) {
+                // Make pixel transparent if inside active window area
+                layerOut.pixels.priority[x] = 0;
+            } else {
+                // Compute integer scroll screen coordinates
+                const uint32 scrollX = fracScrollX >> 8u;
+                const uint32 scrollY = (fracScrollY + vcellScrollY) >> 8u;
+                const CoordU32 scrollCoord{scrollX, scrollY};
+
+                // Plot pixel
+                const Pixel pixel = VDP2FetchScrollBGPixel<false, charMode, fourCellChar, colorFormat, colorMode>(
+                    bgParams, regs2, bgParams.pageBaseAddresses, bgParams.pageShiftH, bgParams.pageShiftV, scrollCoord,
+                    vramFetcher);
+                layerOut.pixels.SetPixel(x, pixel);
+            }
 
-            // Plot pixel
-            const Pixel pixel = VDP2FetchScrollBGPixel<false, charMode, fourCellChar, colorFormat, colorMode>(
-                bgParams, regs2, bgParams.pageBaseAddresses, bgParams.pageShiftH, bgParams.pageShiftV, scrollCoord,
-                vramFetcher);
-            layerOut.pixels.SetPixel(x, pixel);
+            // Increment horizontal coordinate
+            fracScrollX += bgState.scrollIncH;
         }
-
-        // Increment horizontal coordinate
-        fracScrollX += bgState.scrollIncH;
     }
 
     // Fetch one extra tile past the end of the display area
@@ -4511,10 +5057,91 @@ NO_INLINE void SoftwareVDPRenderer::VDP2DrawNormalScrollBG(const VDP2Regs &regs2
     }
 }
 
+template <SoftwareVDPRenderer::CharacterMode charMode, bool fourCellChar, ColorFormat colorFormat, uint32 colorMode>
+FORCE_INLINE void SoftwareVDPRenderer::VDP2DrawScrollBGSpans(const VDP2Regs &regs2, const BGParams &bgParams,
+                                                             LayerOutput &layerOut, VRAMFetcher &vramFetcher,
+                                                             const PixelMask &windowState, uint32 &fracScrollX,
+                                                             uint32 scrollIncH, uint32 scrollY) {
+    const uint32 step = scrollIncH >> 8u;
+
+    uint32 x = 0;
+    while (x < m_HRes) {
+        if (windowState[x]) {
+            // Make the whole run of pixels inside active window area transparent
+            const uint32 runEnd = windowState.Find(false, x, m_HRes);
+            std::fill(layerOut.pixels.priority.begin() + x, layerOut.pixels.priority.begin() + runEnd, 0);
+            fracScrollX += scrollIncH * (runEnd - x);
+            x = runEnd;
+            continue;
+        }
+
+        // Plot the first pixel of the span through the character pipeline
+        const uint32 scrollX = fracScrollX >> 8u;
+        const auto [dotCoord, cellIndex] = VDP2FetchScrollBGCharacter<false, charMode, fourCellChar, colorFormat>(
+            bgParams, bgParams.pageBaseAddresses, bgParams.pageShiftH, bgParams.pageShiftV, {scrollX, scrollY},
+            vramFetcher);
+        layerOut.pixels.SetPixel(
+            x, VDP2FetchCharacterPixel<colorFormat, colorMode>(bgParams, regs2, vramFetcher, dotCoord, cellIndex));
+
+        // The span ends where either the scroll coordinate or the data-offset-adjusted coordinate crosses into the next
+        // cell, or at the end of the line
+        const uint32 spanStart = x;
+        const uint32 spanEnd = std::min({x + (8u - (scrollX & 7u) + step - 1u) / step,
+                                         x + (8u - dotCoord.x() + step - 1u) / step, m_HRes});
+        fracScrollX += scrollIncH;
+        x++;
+
+        while (x < spanEnd && windowState[x]) {
+            layerOut.pixels.priority[x] = 0;
+            fracScrollX += scrollIncH;
+            x++;
+        }
+        if (x == spanEnd) {
+            continue;
+        }
+
+        // The rest of the span finds the same character and cell. Only a 2x2 character's cell tracking may need one
+        // more step after a character fetch; the pipeline stays put after that.
+        if constexpr (fourCellChar) {
+            VDP2FetchScrollBGCharacter<false, charMode, fourCellChar, colorFormat>(
+                bgParams, bgParams.pageBaseAddresses, bgParams.pageShiftH, bgParams.pageShiftV,
+                {fracScrollX >> 8u, scrollY}, vramFetcher);
+        }
+
+        const Character ch = vramFetcher.currChar;
+        CoordU32 cellDotCoord = dotCoord;
+        const uint32 cellAddress = VDP2CalcCellAddress<colorFormat>(bgParams, ch, cellDotCoord, cellIndex);
+        const uint32 flipX = ch.flipH ? 7u : 0u;
+        const uint32 palNum = ch.palNum << 4u;
+
+        // A row of transparent dots needs no per-pixel work. The last pixel still goes through the fetcher so that it
+        // ends up holding the same data it would after fetching every pixel.
+        if (VDP2IsCellRowTransparent<colorFormat>(bgParams, cellAddress, cellDotCoord.y()) &&
+            !windowState.Any(x, spanEnd)) {
+            std::fill(layerOut.pixels.priority.begin() + x, layerOut.pixels.priority.begin() + spanEnd - 1, 0);
+            fracScrollX += scrollIncH * (spanEnd - 1 - x);
+            x = spanEnd - 1;
+        }
+
+        uint32 dotX = dotCoord.x() + (x - spanStart) * step;
+        for (; x < spanEnd; x++, dotX += step) {
+            if (windowState[x]) {
+                layerOut.pixels.priority[x] = 0;
+            } else {
+                const Pixel pixel = VDP2FetchPixel<false, colorFormat, colorMode>(
+                    bgParams, regs2, vramFetcher, cellAddress, 8, {dotX ^ flipX, cellDotCoord.y()}, palNum,
+                    ch.specColorCalc, ch.specPriority);
+                layerOut.pixels.SetPixel(x, pixel);
+            }
+            fracScrollX += scrollIncH;
+        }
+    }
+}
+
 template <ColorFormat colorFormat, uint32 colorMode, bool useVCellScroll, bool deinterlace>
 NO_INLINE void SoftwareVDPRenderer::VDP2DrawNormalBitmapBG(const VDP2Regs &regs2, const BGParams &bgParams,
                                                            LayerOutput &layerOut, const NBGLayerState &bgState,
-                                                           VRAMFetcher &vramFetcher, std::span<const bool> windowState,
+                                                           VRAMFetcher &vramFetcher, const PixelMask &windowState,
                                                            bool altField) {
     const bool doubleDensity = regs2.TVMD.LSMDn == InterlaceMode::DoubleDensity;
     const bool altLine = deinterlace && altField && doubleDensity && !bgParams.lineScrollYEnable;
@@ -4595,7 +5222,7 @@ template <uint32 bgIndex, SoftwareVDPRenderer::CharacterMode charMode, bool four
           uint32 colorMode>
 NO_INLINE void SoftwareVDPRenderer::VDP2DrawRotationScrollBG(const VDP2Regs &regs2, const BGParams &bgParams,
                                                              LayerOutput &layerOut, VRAMFetcher &vramFetcher,
-                                                             std::span<const bool> windowState, bool altField) {
+                                                             const PixelMask &windowState, bool altField) {
     static constexpr bool selRotParam = bgIndex == 0;
 
     const VDP2State &state2 = m_state.state2;
@@ -4707,7 +5334,7 @@ NO_INLINE void SoftwareVDPRenderer::VDP2DrawRotationScrollBG(const VDP2Regs &reg
 
 template <uint32 bgIndex, ColorFormat colorFormat, uint32 colorMode>
 NO_INLINE void SoftwareVDPRenderer::VDP2DrawRotationBitmapBG(const VDP2Regs &regs2, const BGParams &bgParams,
-                                                             LayerOutput &layerOut, std::span<const bool> windowState,
+                                                             LayerOutput &layerOut, const PixelMask &windowState,
                                                              bool altField) {
     static constexpr bool selRotParam = bgIndex == 0;
 
@@ -4921,6 +5548,18 @@ FORCE_INLINE_EX SoftwareVDPRenderer::Pixel
 SoftwareVDPRenderer::VDP2FetchScrollBGPixel(const BGParams &bgParams, const VDP2Regs &regs2,
                                             std::span<const uint32> pageBaseAddresses, uint32 pageShiftH,
                                             uint32 pageShiftV, CoordU32 scrollCoord, VRAMFetcher &vramFetcher) {
+    const auto [dotCoord, cellIndex] = VDP2FetchScrollBGCharacter<rot, charMode, fourCellChar, colorFormat>(
+        bgParams, pageBaseAddresses, pageShiftH, pageShiftV, scrollCoord, vramFetcher);
+
+    // Fetch pixel using character data
+    return VDP2FetchCharacterPixel<colorFormat, colorMode>(bgParams, regs2, vramFetcher, dotCoord, cellIndex);
+}
+
+template <bool rot, SoftwareVDPRenderer::CharacterMode charMode, bool fourCellChar, ColorFormat colorFormat>
+FORCE_INLINE SoftwareVDPRenderer::CharacterDot
+SoftwareVDPRenderer::VDP2FetchScrollBGCharacter(const BGParams &bgParams, std::span<const uint32> pageBaseAddresses,
+                                                uint32 pageShiftH, uint32 pageShiftV, CoordU32 scrollCoord,
+                                                VRAMFetcher &vramFetcher) {
     //      Map (NBGs)              Map (RBGs)
     // +---------+---------+   +----+----+----+----+
     // |         |         |   | A  | B  | C  | D  |
@@ -5108,8 +5747,7 @@ SoftwareVDPRenderer::VDP2FetchScrollBGPixel(const BGParams &bgParams, const VDP2
         }
     }
 
-    // Fetch pixel using character data
-    return VDP2FetchCharacterPixel<colorFormat, colorMode>(bgParams, regs2, vramFetcher, dotCoord, cellIndex);
+    return {dotCoord, cellIndex};
 }
 
 FORCE_INLINE Character SoftwareVDPRenderer::VDP2FetchTwoWordCharacter(const BGParams &bgParams, uint32 pageBaseAddress,
@@ -5197,7 +5835,15 @@ SoftwareVDPRenderer::VDP2FetchCharacterPixel(const BGParams &bgParams, const VDP
     assert(dotCoord.y() < 8);
 
     const Character ch = vramFetcher.currChar;
+    const uint32 cellAddress = VDP2CalcCellAddress<colorFormat>(bgParams, ch, dotCoord, cellIndex);
+
+    return VDP2FetchPixel<false, colorFormat, colorMode>(bgParams, regs2, vramFetcher, cellAddress, 8, dotCoord,
+                                                         ch.palNum << 4u, ch.specColorCalc, ch.specPriority);
+}
 
+template <ColorFormat colorFormat>
+FORCE_INLINE uint32 SoftwareVDPRenderer::VDP2CalcCellAddress(const BGParams &bgParams, const Character &ch,
+                                                             CoordU32 &dotCoord, uint32 cellIndex) {
     // Flip dot coordinates if requested
     if (ch.flipH) {
         dotCoord.x() ^= 7;
@@ -5222,10 +5868,41 @@ SoftwareVDPRenderer::VDP2FetchCharacterPixel(const BGParams &bgParams, const VDP
     }
 
     // Cell addressing uses a fixed offset of 32 bytes
-    const uint32 cellAddress = (ch.charNum + cellIndex) << 5u;
+    return (ch.charNum + cellIndex) << 5u;
+}
 
-    return VDP2FetchPixel<false, colorFormat, colorMode>(bgParams, regs2, vramFetcher, cellAddress, 8, dotCoord,
-                                                         ch.palNum << 4u, ch.specColorCalc, ch.specPriority);
+template <ColorFormat colorFormat>
+FORCE_INLINE bool SoftwareVDPRenderer::VDP2IsCellRowTransparent(const BGParams &bgParams, uint32 cellAddress,
+                                                                uint32 dotY) {
+    if (!bgParams.enableTransparency) {
+        return false;
+    }
+
+    // Size of a cell row in bytes and bits that make a dot opaque, per color format
+    static constexpr uint32 kRowSize = colorFormat == ColorFormat::Palette16    ? 4
+                                       : colorFormat == ColorFormat::Palette256 ? 8
+                                       : colorFormat == ColorFormat::RGB888     ? 32
+                                                                                : 16;
+    static constexpr uint64 kOpaqueMask = colorFormat == ColorFormat::Palette2048 ? 0x07FF07FF07FF07FFull
+                                          : colorFormat == ColorFormat::RGB555    ? 0x8000800080008000ull
+                                          : colorFormat == ColorFormat::RGB888    ? 0x8000000080000000ull
+                                                                                  : ~0ull;
+
+    const uint32 rowAddress = cellAddress + dotY * kRowSize;
+    auto &vram = VDP2GetRendererVRAM();
+    if constexpr (colorFormat == ColorFormat::Palette16) {
+        const uint32 bank = (rowAddress >> 17u) & 3u;
+        return !bgParams.charPatAccess[bank] || util::ReadNE<uint32>(&vram[rowAddress & 0x7FFFC]) == 0;
+    } else {
+        for (uint32 offset = 0; offset < kRowSize; offset += sizeof(uint64)) {
+            const uint32 address = rowAddress + offset;
+            const uint32 bank = (address >> 17u) & 3u;
+            if (bgParams.charPatAccess[bank] && (util::ReadBE<uint64>(&vram[address & 0x7FFF8]) & kOpaqueMask) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 template <ColorFormat colorFormat, uint32 colorMode>
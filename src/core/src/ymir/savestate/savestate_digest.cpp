@@ -0,0 +1,26 @@
+#include <ymir/savestate/savestate_digest.hpp>
+
+#include <xxh3.h>
+
+namespace ymir::savestate {
+
+uint64 StateDigest::Combined() const {
+    return XXH3_64bits(components.data(), sizeof(components));
+}
+
+const char *StateDigest::GetComponentName(Component component) {
+    switch (component) {
+    case Component::Timing: return "Timing";
+    case Component::System: return "System";
+    case Component::MasterSH2: return "Master SH-2";
+    case Component::SlaveSH2: return "Slave SH-2";
+    case Component::SCU: return "SCU";
+    case Component::SMPC: return "SMPC";
+    case Component::VDP: return "VDP";
+    case Component::SCSP: return "SCSP";
+    case Component::CDBlock: return "CD Block";
+    default: return "Unknown";
+    }
+}
+
+} // namespace ymir::savestate
@@ -4,8 +4,13 @@
 
 #include <ymir/util/dev_log.hpp>
 
+#include <xxh3.h>
+
+#include <algorithm>
 #include <bit>
 #include <cassert>
+#include <type_traits>
+#include <vector>
 
 namespace ymir {
 
@@ -48,6 +53,12 @@ namespace grp {
 
 } // namespace grp
 
+// Bounds of the master/slave SH-2 synchronization interval, in cycles.
+// The interval doubles after every slice without interactions between the CPUs and drops back to the minimum as soon as
+// they interact. The scheduler deadline always bounds the slice.
+static constexpr uint64 kSH2SyncMinStep = 32;
+static constexpr uint64 kSH2SyncMaxStep = 65536;
+
 Saturn::Saturn()
     : masterSH2(mainBus, true)
     , slaveSH2(mainBus, false)
@@ -57,7 +68,9 @@ Saturn::Saturn()
     , SCSP(m_scheduler, configuration.audio)
     , CDBlock(m_scheduler, m_disc, m_fs, configuration.cdblock)
     , SH1(SH1Bus)
-    , CDDrive(m_scheduler, m_disc, m_fs, configuration.cdblock) {
+    , CDDrive(m_scheduler, m_disc, m_fs, configuration.cdblock)
+    , SH2DecodeCache(mainBus)
+    , m_sh2Runner(masterSH2, slaveSH2, mainBus) {
 
     mainBus.MapNormal(
         0x000'0000, 0x7FF'FFFF, nullptr,
@@ -149,6 +162,11 @@ Saturn::Saturn()
     masterSH2.BindEmulateCacheOption(m_emulateSH2Caches);
     slaveSH2.BindEmulateCacheOption(m_emulateSH2Caches);
 
+    // Only memory exclusively written through the main bus can be safely pre-decoded
+    SH2DecodeCache.AddRegion(0x000'0000, 0x00F'FFFF); // IPL ROM
+    SH2DecodeCache.AddRegion(0x020'0000, 0x02F'FFFF); // Low WRAM
+    SH2DecodeCache.AddRegion(0x600'0000, 0x7FF'FFFF); // High WRAM
+
     ConfigureAccessCycles(false);
 
     m_enableDebugTracing = false;
@@ -159,6 +177,13 @@ Saturn::Saturn()
         [&](const std::vector<core::config::sys::Region> &regions) { UpdatePreferredRegionOrder(regions); });
     configuration.system.debugTracing.Observe([&](bool enabled) { UpdateDebugTracing(enabled); });
     configuration.system.emulateSH2Cache.Observe([&](bool enabled) { UpdateSH2CacheEmulation(enabled); });
+    configuration.system.sh2DecodeCache.ObserveAndNotify([&](bool enabled) { UpdateSH2DecodeCache(enabled); });
+    configuration.system.scuDSPBlockExecutor.Observe(SCU.GetDSP().blockExecutor);
+    configuration.system.adaptiveSH2Sync.ObserveAndNotify([&](bool enabled) {
+        m_adaptiveSH2Sync = enabled;
+        UpdateSH2SyncMode();
+    });
+    configuration.system.parallelSH2.ObserveAndNotify([&](bool enabled) { m_sh2Runner.SetEnabled(enabled); });
     configuration.system.videoStandard.Observe(
         [&](core::config::sys::VideoStandard videoStandard) { UpdateVideoStandard(videoStandard); });
     configuration.system.sh2OverclockFactor.Observe([&](uint32 factor) { UpdateSH2OverclockFactor(factor); });
@@ -174,12 +199,15 @@ void Saturn::Reset(bool hard) {
     if (hard) {
         m_scheduler.Reset();
     }
+    SH2DecodeCache.Flush();
 
     masterSH2.Reset(hard);
     slaveSH2.Reset(hard);
     slaveSH2Enabled = false;
     m_msh2SpilloverCycles = 0;
     m_ssh2SpilloverCycles = 0;
+    m_sh2SyncStep = kSH2SyncMinStep;
+    SH2SyncMonitor.Reset();
     m_sh1SpilloverCycles = 0;
     m_sh1FracCycles = 0;
 
@@ -218,6 +246,7 @@ const sys::ClockRatios &Saturn::GetClockRatios() const noexcept {
 
 void Saturn::LoadIPL(std::span<uint8, sys::kIPLSize> ipl) {
     mem.LoadIPL(ipl);
+    SH2DecodeCache.Flush();
 }
 
 void Saturn::LoadCDBlockROM(std::span<uint8, sh1::kROMSize> rom) {
@@ -271,6 +300,8 @@ void Saturn::LoadDisc(media::Disc &&disc) {
     VDP.vdp2AccessPatternsConfig.relaxedBitmapCPAccessChecks =
         hasFlag(db::GameInfo::Flags::RelaxedVDP2BitmapCPAccessChecks);
     VDP.SetVirtuaGunJitter(hasFlag(db::GameInfo::Flags::VirtuaGunJitter));
+    m_strictSH2Sync = hasFlag(db::GameInfo::Flags::StrictSH2Sync);
+    UpdateSH2SyncMode();
 }
 
 void Saturn::EjectDisc() {
@@ -375,6 +406,7 @@ void Saturn::SaveState(savestate::SaveState &state) const {
     state.system.slaveSH2Enabled = slaveSH2Enabled;
     state.msh2SpilloverCycles = m_msh2SpilloverCycles;
     state.ssh2SpilloverCycles = m_ssh2SpilloverCycles;
+    state.sh2SyncStep = m_sh2SyncStep;
     masterSH2.SaveState(state.msh2);
     slaveSH2.SaveState(state.ssh2);
     SCU.SaveState(state.scu);
@@ -395,6 +427,57 @@ void Saturn::SaveState(savestate::SaveState &state) const {
     state.discHash = GetDiscHash();
 }
 
+savestate::StateDigest Saturn::CalcStateDigest() const {
+    using Component = savestate::StateDigest::Component;
+
+    if (!m_digestState) {
+        m_digestState = std::make_unique<savestate::SaveState>();
+    }
+    savestate::SaveState &state = *m_digestState;
+    SaveState(state);
+
+    // Vectors are hashed by contents. Swap them out of the state so that their heap pointers don't end up in the digest.
+    std::vector<uint8> cartData{};
+    std::vector<uint8> intbackReport{};
+    cartData.swap(state.scu.cartData);
+    intbackReport.swap(state.smpc.intback.report);
+
+    savestate::StateDigest digest{};
+    auto hash = [&](Component component, const auto &...parts) {
+        uint64 value = 0;
+        auto add = [&](const auto &part) {
+            using T = std::remove_cvref_t<decltype(part)>;
+            if constexpr (std::is_same_v<T, std::vector<uint8>>) {
+                value = XXH3_64bits_withSeed(part.data(), part.size(), value);
+            } else {
+                value = XXH3_64bits_withSeed(&part, sizeof(part), value);
+            }
+        };
+        (add(parts), ...);
+        digest.components[static_cast<size_t>(component)] = value;
+    };
+
+    hash(Component::Timing, state.scheduler, state.msh2SpilloverCycles, state.ssh2SpilloverCycles, state.sh2SyncStep);
+    hash(Component::System, state.system);
+    hash(Component::MasterSH2, state.msh2);
+    hash(Component::SlaveSH2, state.ssh2);
+    hash(Component::SCU, state.scu, cartData);
+    hash(Component::SMPC, state.smpc, intbackReport);
+    hash(Component::VDP, state.vdp);
+    hash(Component::SCSP, state.scsp);
+    if (state.cdblockLLE) {
+        hash(Component::CDBlock, state.sh1, state.ygr, state.cddrive, state.cdblockDRAM, state.sh1SpilloverCycles,
+             state.sh1FracCycles);
+    } else {
+        hash(Component::CDBlock, state.cdblock);
+    }
+
+    // Hand the buffers back so their allocations are reused next time
+    state.scu.cartData.swap(cartData);
+    state.smpc.intback.report.swap(intbackReport);
+    return digest;
+}
+
 bool Saturn::LoadState(const savestate::SaveState &state, bool skipROMChecks) {
     if (!m_scheduler.ValidateState(state.scheduler)) {
         return false;
@@ -449,9 +532,12 @@ bool Saturn::LoadState(const savestate::SaveState &state, bool skipROMChecks) {
     m_scheduler.LoadState(state.scheduler);
     m_system.LoadState(state.system);
     mem.LoadState(state.system);
+    SH2DecodeCache.Revalidate();
     slaveSH2Enabled = state.system.slaveSH2Enabled;
     m_msh2SpilloverCycles = state.msh2SpilloverCycles;
     m_ssh2SpilloverCycles = state.ssh2SpilloverCycles;
+    m_sh2SyncStep = std::clamp(state.sh2SyncStep, kSH2SyncMinStep, kSH2SyncMaxStep);
+    SH2SyncMonitor.Reset();
     masterSH2.LoadState(state.msh2);
     slaveSH2.LoadState(state.ssh2);
     SCU.LoadState(state.scu);
@@ -518,8 +604,6 @@ void Saturn::RunFrameImpl() {
 
 template <bool debug, bool enableSH2Cache, bool cdblockLLE>
 bool Saturn::Run() {
-    static constexpr uint64 kSH2SyncMaxStep = 32;
-
     const uint64 cycles = static_config::max_timing_granularity ? 1 : std::max<sint64>(m_scheduler.RemainingCount(), 0);
 
     uint64 execCycles;
@@ -534,10 +618,28 @@ bool Saturn::Run() {
             uint64 slaveCycles = m_ssh2SpilloverCycles;
             do {
                 const uint64 prevExecCycles = execCycles;
-                const uint64 targetCycles = std::min(execCycles + kSH2SyncMaxStep, cycles);
-                execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
-                slaveCycles = slaveSH2.Advance<debug, enableSH2Cache>(execCycles, slaveCycles);
+                const uint64 targetCycles = std::min(execCycles + m_sh2SyncStep, cycles);
+                bool parallel = false;
+                if constexpr (!debug && !enableSH2Cache) {
+                    parallel = m_sh2Runner.IsEnabled() && m_sh2SyncStep == kSH2SyncMaxStep;
+                }
+                if (parallel) {
+                    execCycles = AdvanceSH2sInParallel(targetCycles, execCycles, slaveCycles);
+                } else {
+                    execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
+                    slaveCycles = slaveSH2.Advance<debug, enableSH2Cache>(execCycles, slaveCycles);
+                }
                 SCU.Advance<debug>(execCycles - prevExecCycles);
+                if (m_adaptiveSH2Sync && !m_strictSH2Sync) {
+                    // Run longer slices while the CPUs work independently; go back to lockstep once they interact.
+                    // The SCU only catches up at the end of each slice, so keep lockstep while it has work to do.
+                    const bool scuBusy = SCU.IsDMAActive() || SCU.GetDSP().programExecuting;
+                    if (SH2SyncMonitor.ConsumeInteraction() || scuBusy) {
+                        m_sh2SyncStep = kSH2SyncMinStep;
+                    } else {
+                        m_sh2SyncStep = std::min(m_sh2SyncStep * 2, kSH2SyncMaxStep);
+                    }
+                }
                 if constexpr (debug) {
                     if (m_debugBreakMgr.IsDebugBreakRaised()) {
                         break;
@@ -558,7 +660,7 @@ bool Saturn::Run() {
         } else {
             do {
                 const uint64 prevExecCycles = execCycles;
-                const uint64 targetCycles = std::min(execCycles + kSH2SyncMaxStep, cycles);
+                const uint64 targetCycles = std::min(execCycles + kSH2SyncMinStep, cycles);
                 execCycles = masterSH2.Advance<debug, enableSH2Cache>(targetCycles, execCycles);
                 SCU.Advance<debug>(execCycles - prevExecCycles);
                 if constexpr (debug) {
@@ -598,6 +700,31 @@ bool Saturn::Run() {
     return true;
 }
 
+uint64 Saturn::AdvanceSH2sInParallel(uint64 targetCycles, uint64 execCycles, uint64 &slaveCycles) {
+    // Neither the decode cache nor the sync monitor can be shared across threads
+    slaveSH2.UseDecodeCache(nullptr);
+    masterSH2.UseSyncMonitor(nullptr);
+    slaveSH2.UseSyncMonitor(nullptr);
+
+    m_sh2Runner.Start(targetCycles, slaveCycles);
+    execCycles = masterSH2.Advance<false, false>(targetCycles, execCycles);
+    if (m_sh2Runner.Finish(slaveCycles)) {
+        // The master SH-2 may overshoot the target by a few cycles
+        if (slaveCycles < execCycles) {
+            slaveCycles = slaveSH2.Resume<false, false>(execCycles, slaveCycles);
+        }
+    } else {
+        // The CPUs interacted; run the slave SH-2 again after the master SH-2 and go back to lockstep
+        slaveCycles = slaveSH2.Advance<false, false>(execCycles, slaveCycles);
+        SH2SyncMonitor.SignalInteraction();
+    }
+
+    slaveSH2.UseDecodeCache(configuration.system.sh2DecodeCache ? &SH2DecodeCache : nullptr);
+    masterSH2.UseSyncMonitor(&SH2SyncMonitor);
+    slaveSH2.UseSyncMonitor(&SH2SyncMonitor);
+    return execCycles;
+}
+
 template <bool debug, bool enableSH2Cache, bool cdblockLLE>
 uint64 Saturn::StepMasterSH2Impl() {
     while (SCU.IsDMAActive()) {
@@ -815,6 +942,22 @@ void Saturn::UpdateSH2CacheEmulation(bool enabled) {
     UpdateFunctionPointers();
 }
 
+void Saturn::UpdateSH2DecodeCache(bool enabled) {
+    SH2DecodeCache.Flush();
+    masterSH2.UseDecodeCache(enabled ? &SH2DecodeCache : nullptr);
+    slaveSH2.UseDecodeCache(enabled ? &SH2DecodeCache : nullptr);
+}
+
+void Saturn::UpdateSH2SyncMode() {
+    const bool adaptive = m_adaptiveSH2Sync && !m_strictSH2Sync;
+    SH2SyncMonitor.Reset();
+    masterSH2.UseSyncMonitor(adaptive ? &SH2SyncMonitor : nullptr);
+    slaveSH2.UseSyncMonitor(adaptive ? &SH2SyncMonitor : nullptr);
+    if (!adaptive) {
+        m_sh2SyncStep = kSH2SyncMinStep;
+    }
+}
+
 void Saturn::UpdateSH2OverclockFactor(uint32 factor) {
     m_system.sh2OverclockFactor = factor;
     m_system.UpdateClockRatios();
@@ -0,0 +1,343 @@
+#include <ymir/util/thread_placement.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+    #include <fstream>
+
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    #include <cerrno>
+#endif
+
+namespace util {
+
+namespace {
+
+struct RegisteredThread {
+    uint64_t id;
+    ThreadRole role;
+    bool modified = false; // Whether the placement of the thread was changed and needs restoring
+#if defined(__linux__)
+    pid_t tid;
+    cpu_set_t affinity;
+    int nice;
+    int policy;
+    sched_param param;
+#endif
+};
+
+struct Registry {
+    std::mutex mutex;
+    ThreadPlacements placements{};
+    bool automatic = false;
+    bool topologyKnown = false;
+    ThreadPlacements automaticAffinities{};
+    std::vector<RegisteredThread> threads;
+    uint64_t nextID = 0;
+    bool applied = true;
+};
+
+// Intentionally leaked: thread pool workers unregister while static objects are being destroyed
+Registry &GetRegistry() {
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+ThreadPlacement GetEffectivePlacement(const Registry &registry, ThreadRole role) {
+    const size_t index = static_cast<size_t>(role);
+    ThreadPlacement placement{};
+    if (registry.automatic) {
+        placement.Merge(registry.automaticAffinities[index]);
+    }
+    placement.Merge(registry.placements[index]);
+    return placement;
+}
+
+#if defined(__linux__)
+
+bool IsEmpty(const ThreadPlacement &placement) {
+    return !placement.affinity && !placement.nice && !placement.realtimePriority;
+}
+
+RegisteredThread CaptureCurrentThread(uint64_t id, ThreadRole role) {
+    RegisteredThread thread{.id = id, .role = role};
+    thread.tid = static_cast<pid_t>(syscall(SYS_gettid));
+    if (sched_getaffinity(thread.tid, sizeof(thread.affinity), &thread.affinity) != 0) {
+        CPU_ZERO(&thread.affinity);
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &thread.affinity);
+        }
+    }
+    errno = 0;
+    thread.nice = getpriority(PRIO_PROCESS, static_cast<id_t>(thread.tid));
+    if (errno != 0) {
+        thread.nice = 0;
+    }
+    thread.policy = sched_getscheduler(thread.tid);
+    if (thread.policy < 0 || sched_getparam(thread.tid, &thread.param) != 0) {
+        thread.policy = SCHED_OTHER;
+        thread.param = {};
+    }
+    return thread;
+}
+
+bool Apply(RegisteredThread &thread, const ThreadPlacement &placement) {
+    if (IsEmpty(placement) && !thread.modified) {
+        return true;
+    }
+    thread.modified = !IsEmpty(placement);
+
+    // Unset fields fall back to what the thread had when it registered
+    bool applied = true;
+    cpu_set_t affinity = thread.affinity;
+    if (placement.affinity) {
+        CPU_ZERO(&affinity);
+        for (uint64_t cpus = *placement.affinity; cpus != 0; cpus &= cpus - 1) {
+            CPU_SET(std::countr_zero(cpus), &affinity);
+        }
+    }
+    applied &= sched_setaffinity(thread.tid, sizeof(affinity), &affinity) == 0;
+
+    if (placement.realtimePriority) {
+        sched_param param{};
+        param.sched_priority = std::clamp(*placement.realtimePriority, sched_get_priority_min(SCHED_FIFO),
+                                          sched_get_priority_max(SCHED_FIFO));
+        applied &= sched_setscheduler(thread.tid, SCHED_FIFO, &param) == 0;
+    } else {
+        applied &= sched_setscheduler(thread.tid, thread.policy, &thread.param) == 0;
+    }
+
+    // Linux applies nice values to individual threads rather than the whole process
+    applied &= setpriority(PRIO_PROCESS, static_cast<id_t>(thread.tid), placement.nice.value_or(thread.nice)) == 0;
+    return applied;
+}
+
+std::optional<int64_t> ReadSysfsValue(const std::string &path) {
+    std::ifstream in{path};
+    int64_t value;
+    if (in >> value) {
+        return value;
+    }
+    return std::nullopt;
+}
+
+#else
+
+RegisteredThread CaptureCurrentThread(uint64_t id, ThreadRole role) {
+    return {.id = id, .role = role};
+}
+
+bool Apply(RegisteredThread &, const ThreadPlacement &) {
+    return true;
+}
+
+#endif
+
+std::string_view NextToken(std::string_view &text, char separator) {
+    const size_t pos = text.find(separator);
+    const std::string_view token = text.substr(0, pos);
+    text = pos == std::string_view::npos ? std::string_view{} : text.substr(pos + 1);
+    return token;
+}
+
+std::optional<int> ParseInt(std::string_view text, int min, int max) {
+    int value;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size() || value < min || value > max) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<uint64_t> ParseCPUList(std::string_view text) {
+    uint64_t cpus = 0;
+    while (!text.empty()) {
+        std::string_view range = NextToken(text, ',');
+        const auto first = ParseInt(NextToken(range, '-'), 0, 63);
+        const auto last = range.empty() ? first : ParseInt(range, 0, 63);
+        if (!first || !last || *last < *first) {
+            return std::nullopt;
+        }
+        for (int cpu = *first; cpu <= *last; ++cpu) {
+            cpus |= uint64_t{1} << cpu;
+        }
+    }
+    if (cpus == 0) {
+        return std::nullopt;
+    }
+    return cpus;
+}
+
+std::optional<ThreadRole> ParseThreadRole(std::string_view name) {
+    static constexpr std::pair<std::string_view, ThreadRole> kRoles[] = {
+        {"main", ThreadRole::Emulation},
+        {"vdp1", ThreadRole::VDP1Render},
+        {"vdp2", ThreadRole::VDP2Render},
+        {"deinterlace", ThreadRole::VDPDeinterlace},
+        {"scsp", ThreadRole::SCSP},
+        {"sh2", ThreadRole::SH2Speculation},
+        {"worker", ThreadRole::PoolWorker},
+    };
+    for (const auto &[roleName, role] : kRoles) {
+        if (name == roleName) {
+            return role;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+ScopedThreadPlacement::ScopedThreadPlacement(ThreadRole role) {
+    auto &registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+    m_id = registry.nextID++;
+    auto &thread = registry.threads.emplace_back(CaptureCurrentThread(m_id, role));
+    registry.applied &= Apply(thread, GetEffectivePlacement(registry, role));
+}
+
+ScopedThreadPlacement::~ScopedThreadPlacement() {
+    auto &registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+    auto it = std::find_if(registry.threads.begin(), registry.threads.end(),
+                           [&](const RegisteredThread &thread) { return thread.id == m_id; });
+    if (it != registry.threads.end()) {
+        Apply(*it, {});
+        registry.threads.erase(it);
+    }
+}
+
+void ConfigureThreadPlacement(const ThreadPlacements &placements, bool automatic) {
+    auto &registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+    registry.placements = placements;
+    registry.automatic = automatic;
+    if (automatic && !registry.topologyKnown) {
+        registry.automaticAffinities = ComputeAutomaticAffinities(GetCPUCores());
+        registry.topologyKnown = true;
+    }
+
+    registry.applied = true;
+    for (auto &thread : registry.threads) {
+        registry.applied &= Apply(thread, GetEffectivePlacement(registry, thread.role));
+    }
+}
+
+bool IsThreadPlacementApplied() {
+    auto &registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+    return registry.applied;
+}
+
+std::vector<CPUCore> GetCPUCores() {
+    std::vector<CPUCore> cores{};
+#if defined(__linux__)
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return cores;
+    }
+
+    // Logical CPUs sharing a package and core ID are SMT siblings of one physical core. Hybrid and big.LITTLE CPUs
+    // report the relative performance of their cores in cpu_capacity; otherwise the maximum clock rate stands in.
+    std::vector<std::pair<int64_t, int64_t>> coreIDs{};
+    for (int cpu = 0; cpu < 64; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        const std::pair coreID{ReadSysfsValue(path + "/topology/physical_package_id").value_or(0),
+                               ReadSysfsValue(path + "/topology/core_id").value_or(cpu)};
+        auto capacity = ReadSysfsValue(path + "/cpu_capacity");
+        if (!capacity) {
+            capacity = ReadSysfsValue(path + "/cpufreq/cpuinfo_max_freq");
+        }
+
+        const size_t index = std::find(coreIDs.begin(), coreIDs.end(), coreID) - coreIDs.begin();
+        if (index == coreIDs.size()) {
+            coreIDs.push_back(coreID);
+            cores.push_back({.cpus = 0, .capacity = 0});
+        }
+        auto &core = cores[index];
+        core.cpus |= uint64_t{1} << cpu;
+        core.capacity = std::max(core.capacity, static_cast<uint32_t>(capacity.value_or(0)));
+    }
+
+    std::stable_sort(cores.begin(), cores.end(),
+                     [](const CPUCore &lhs, const CPUCore &rhs) { return lhs.capacity > rhs.capacity; });
+#endif
+    return cores;
+}
+
+ThreadPlacements ComputeAutomaticAffinities(std::span<const CPUCore> cores) {
+    ThreadPlacements placements{};
+    if (cores.size() < 2) {
+        return placements;
+    }
+
+    auto assign = [&](ThreadRole role, uint64_t cpus) { placements[static_cast<size_t>(role)].affinity = cpus; };
+
+    // Dedicated threads in order of how much their placement affects frame times
+    static constexpr ThreadRole kDedicatedRoles[] = {ThreadRole::VDP2Render, ThreadRole::VDP1Render, ThreadRole::SCSP,
+                                                     ThreadRole::SH2Speculation, ThreadRole::VDPDeinterlace};
+
+    assign(ThreadRole::Emulation, cores[0].cpus);
+    const auto others = cores.subspan(1);
+    uint64_t workerCPUs = 0;
+    for (size_t i = 0; i < std::size(kDedicatedRoles); ++i) {
+        assign(kDedicatedRoles[i], others[i % others.size()].cpus);
+    }
+    for (const auto &core : others) {
+        workerCPUs |= core.cpus;
+    }
+    assign(ThreadRole::PoolWorker, workerCPUs);
+    return placements;
+}
+
+std::optional<ThreadPlacements> ParseThreadPlacements(std::string_view spec) {
+    ThreadPlacements placements{};
+    while (!spec.empty()) {
+        std::string_view entry = NextToken(spec, ';');
+        if (entry.empty()) {
+            continue;
+        }
+        const auto role = ParseThreadRole(NextToken(entry, ':'));
+        if (!role) {
+            return std::nullopt;
+        }
+        auto &placement = placements[static_cast<size_t>(*role)];
+        while (!entry.empty()) {
+            std::string_view value = NextToken(entry, ':');
+            const std::string_view key = NextToken(value, '=');
+            if (key == "cpus") {
+                placement.affinity = ParseCPUList(value);
+                if (!placement.affinity) {
+                    return std::nullopt;
+                }
+            } else if (key == "nice") {
+                placement.nice = ParseInt(value, -20, 19);
+                if (!placement.nice) {
+                    return std::nullopt;
+                }
+            } else if (key == "fifo") {
+                placement.realtimePriority = ParseInt(value, 1, 99);
+                if (!placement.realtimePriority) {
+                    return std::nullopt;
+                }
+            } else {
+                return std::nullopt;
+            }
+        }
+    }
+    return placements;
+}
+
+} // namespace util
@@ -0,0 +1,140 @@
+#include <ymir/util/thread_pool.hpp>
+
+#include <ymir/util/thread_name.hpp>
+#include <ymir/util/thread_placement.hpp>
+
+#include <algorithm>
+
+namespace util {
+
+ThreadPool::ThreadPool(size_t threadBudget)
+    : m_threadBudget(threadBudget != 0 ? threadBudget : DefaultThreadBudget()) {}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{m_mutex};
+        m_quit = true;
+    }
+    m_wakeCond.notify_all();
+    for (auto &worker : m_workers) {
+        worker.join();
+    }
+}
+
+ThreadPool &ThreadPool::Shared() {
+    static ThreadPool pool{};
+    return pool;
+}
+
+size_t ThreadPool::DefaultThreadBudget() {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::SetThreadBudget(size_t threadBudget) {
+    m_threadBudget.store(threadBudget != 0 ? threadBudget : DefaultThreadBudget(), std::memory_order_relaxed);
+}
+
+size_t ThreadPool::GetAvailableHelperCount() const {
+    // One thread of the budget is the caller
+    const size_t budget = GetThreadBudget();
+    const size_t taken = GetDedicatedThreadCount() + 1;
+    return budget > taken ? budget - taken : 0;
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)> &task) {
+    if (count == 0) {
+        return;
+    }
+
+    // Only one batch runs on the workers at a time; any other batch runs inline on its caller
+    const bool ownsWorkers = !m_batchRunning.exchange(true, std::memory_order_acquire);
+    const size_t helpers = ownsWorkers ? std::min(count - 1, GetAvailableHelperCount()) : 0;
+    if (helpers == 0) {
+        if (ownsWorkers) {
+            m_batchRunning.store(false, std::memory_order_release);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    const size_t participants = helpers + 1;
+    if (m_rangeCapacity < participants) {
+        m_ranges = std::make_unique<Range[]>(participants);
+        m_rangeCapacity = participants;
+    }
+    for (size_t i = 0; i < participants; ++i) {
+        m_ranges[i].next.store(count * i / participants, std::memory_order_relaxed);
+        m_ranges[i].end = count * (i + 1) / participants;
+    }
+
+    {
+        std::lock_guard lock{m_mutex};
+        while (m_workers.size() < helpers) {
+            m_workers.emplace_back([this] { WorkerLoop(); });
+        }
+        m_task = &task;
+        m_rangeCount = participants;
+        m_openSlots = helpers;
+        m_nextSlot = 1;
+        ++m_generation;
+    }
+    m_wakeCond.notify_all();
+
+    RunRanges(0);
+
+    {
+        // Every task has been claimed by now; keep late workers out and wait for those still finishing their tasks
+        std::unique_lock lock{m_mutex};
+        m_openSlots = 0;
+        m_doneCond.wait(lock, [this] { return m_activeHelpers == 0; });
+        m_task = nullptr;
+    }
+    m_batchRunning.store(false, std::memory_order_release);
+}
+
+void ThreadPool::WorkerLoop() {
+    SetCurrentThreadName("Thread pool worker");
+    ScopedThreadPlacement placement{ThreadRole::PoolWorker};
+
+    uint64_t seenGeneration = 0;
+    while (true) {
+        size_t participant;
+        {
+            std::unique_lock lock{m_mutex};
+            m_wakeCond.wait(lock, [&] { return m_quit || m_generation != seenGeneration; });
+            if (m_quit) {
+                return;
+            }
+            seenGeneration = m_generation;
+            if (m_openSlots == 0) {
+                continue;
+            }
+            --m_openSlots;
+            participant = m_nextSlot++;
+            ++m_activeHelpers;
+        }
+
+        RunRanges(participant);
+
+        std::lock_guard lock{m_mutex};
+        if (--m_activeHelpers == 0) {
+            m_doneCond.notify_one();
+        }
+    }
+}
+
+void ThreadPool::RunRanges(size_t participant) {
+    const auto &task = *m_task;
+    const size_t rangeCount = m_rangeCount;
+    for (size_t offset = 0; offset < rangeCount; ++offset) {
+        Range &range = m_ranges[(participant + offset) % rangeCount];
+        for (size_t i = range.next.fetch_add(1, std::memory_order_relaxed); i < range.end;
+             i = range.next.fetch_add(1, std::memory_order_relaxed)) {
+            task(i);
+        }
+    }
+}
+
+} // namespace util
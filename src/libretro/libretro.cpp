@@ -45,6 +45,9 @@ static const unsigned g_memdesc_count = sizeof(g_memdesc) / sizeof(g_memdesc[0])
 // Whether the frontend supports RETRO_DEVICE_ID_JOYPAD_MASK (single-call input read)
 static bool g_input_bitmask_supported = false;
 
+// Whether the frontend accepts a null framebuffer as "repeat the previous frame"
+static bool g_can_dupe = false;
+
 // Helper function for logging
 static void brimir_log(retro_log_level level, const char* fmt, ...) {
     if (!log_cb) return;
@@ -82,6 +85,61 @@ static const char* get_option_value(const char* key, const char* default_value =
     return default_value;
 }
 
+// Read the RetroPad state of a port as a libretro button mask
+static uint16_t read_joypad_buttons(unsigned port) {
+    if (!input_state_cb) {
+        return 0;
+    }
+
+    if (g_input_bitmask_supported) {
+        // Single call returns all buttons as a bitmask - bits match RETRO_DEVICE_ID_JOYPAD_* values
+        return static_cast<uint16_t>(input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_MASK));
+    }
+
+    // Fallback: query each button individually
+    uint16_t buttons = 0;
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_B))      buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_B);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_Y))      buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_Y);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_SELECT)) buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_SELECT);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_START))  buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_START);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_UP))     buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_UP);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_DOWN))   buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_DOWN);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_LEFT))   buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_LEFT);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_RIGHT))  buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_RIGHT);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_A))      buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_A);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_X))      buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_X);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L))      buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_L);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R))      buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_R);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L2))     buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_L2);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R2))     buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_R2);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L3))     buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_L3);
+    if (input_state_cb(port, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R3))     buttons |= (1 << RETRO_DEVICE_ID_JOYPAD_R3);
+    return buttons;
+}
+
+// Late input polling: set when the frontend has been polled during the current retro_run
+static bool g_input_polled_this_frame = false;
+
+// Last button mask read from port 1; holding the rewind button rewinds when the core rewind buffer is enabled
+static uint16_t g_port1_buttons = 0;
+
+// Port 1 button mask that triggers Core Rewind, or zero when unbound
+static uint16_t g_rewind_button_mask = 0;
+
+// Invoked by the core from the SMPC peripheral report callbacks in late polling mode.
+// Runs on the emulation thread, inside retro_run.
+static uint16_t late_input_state(unsigned int port) {
+    if (!g_input_polled_this_frame && input_poll_cb) {
+        input_poll_cb();
+        g_input_polled_this_frame = true;
+    }
+    const uint16_t buttons = read_joypad_buttons(port);
+    if (port == 0) {
+        g_port1_buttons = buttons;
+    }
+    return buttons;
+}
+
 // Cached core option values so Quick Menu changes can be applied live each frame.
 // Defaults here must stay in sync with src/libretro/options.cpp for each key.
 struct OptionCache {
@@ -98,8 +156,71 @@ struct OptionCache {
     std::string cd_preload = "enabled";
     std::string threaded_vdp1 = "enabled";
     std::string threaded_vdp2 = "enabled";
+    std::string runahead = "0";
+    std::string late_input_poll = "disabled";
+    std::string rewind = "0";
+    std::string rewind_button = "disabled";
+    std::string frameskip = "0";
+    std::string thread_budget = "auto";
+    std::string thread_placement = "disabled";
+    std::string thread_priority = "normal";
 } g_options;
 
+// Reported by the frontend before each retro_run while auto frameskip is selected
+static void audio_buffer_status(bool active, unsigned /*occupancy*/, bool underrun_likely) {
+    if (g_core) {
+        g_core->SetAudioBufferStatus(active, underrun_likely);
+    }
+}
+
+static void set_rewind_button(const char* value) {
+    if (strcmp(value, "l3") == 0) {
+        g_rewind_button_mask = 1 << RETRO_DEVICE_ID_JOYPAD_L3;
+    } else if (strcmp(value, "r3") == 0) {
+        g_rewind_button_mask = 1 << RETRO_DEVICE_ID_JOYPAD_R3;
+    } else if (strcmp(value, "select") == 0) {
+        g_rewind_button_mask = 1 << RETRO_DEVICE_ID_JOYPAD_SELECT;
+    } else {
+        g_rewind_button_mask = 0;
+    }
+}
+
+static void set_frameskip(const char* value) {
+    const bool auto_mode = strcmp(value, "auto") == 0;
+    if (auto_mode) {
+        g_core->SetFrameskip(brimir::FrameskipMode::Auto);
+    } else {
+        g_core->SetFrameskip(brimir::FrameskipMode::Fixed, static_cast<unsigned int>(atoi(value)));
+    }
+
+    // Only auto mode listens to the audio buffer; without reports it falls back to frame timing
+    g_core->SetAudioBufferStatus(false, false);
+    if (environ_cb) {
+        struct retro_audio_buffer_status_callback status_cb = { audio_buffer_status };
+        environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK, auto_mode ? &status_cb : nullptr);
+    }
+}
+
+// Per-thread overrides for kiosks and other dedicated setups come from the environment, since core options can only
+// offer fixed choices
+static void set_thread_placement(const char* /*value*/) {
+    brimir::ThreadPriority priority = brimir::ThreadPriority::Normal;
+    if (g_options.thread_priority == "high") {
+        priority = brimir::ThreadPriority::High;
+    } else if (g_options.thread_priority == "realtime") {
+        priority = brimir::ThreadPriority::Realtime;
+    }
+
+    const char* overrides = getenv("BRIMIR_THREAD_PLACEMENT");
+    if (!brimir::CoreWrapper::SetThreadPlacement(g_options.thread_placement == "auto", priority, overrides)) {
+        brimir_log(RETRO_LOG_WARN, "Ignoring malformed BRIMIR_THREAD_PLACEMENT: %s", overrides);
+    }
+    if (!brimir::CoreWrapper::IsThreadPlacementApplied()) {
+        brimir_log(RETRO_LOG_WARN, "Thread placement was only partially applied; raising thread priorities requires "
+                                   "CAP_SYS_NICE or higher RLIMIT_NICE/RLIMIT_RTPRIO limits");
+    }
+}
+
 static void apply_core_options(bool force) {
     if (!g_core) return;
 
@@ -127,6 +248,14 @@ static void apply_core_options(bool force) {
     apply("brimir_cd_preload",              g_options.cd_preload,       [](const char* v){ g_core->SetDiscPreloadEnabled(strcmp(v, "enabled") == 0); });
     apply("brimir_threaded_vdp1",           g_options.threaded_vdp1,    [](const char* v){ g_core->SetThreadedVDP1(strcmp(v, "enabled") == 0); });
     apply("brimir_threaded_vdp2",           g_options.threaded_vdp2,    [](const char* v){ g_core->SetThreadedVDP2(strcmp(v, "enabled") == 0); });
+    apply("brimir_runahead",                g_options.runahead,         [](const char* v){ g_core->SetRunAheadFrames(static_cast<unsigned int>(atoi(v))); });
+    apply("brimir_late_input_poll",         g_options.late_input_poll,  [](const char* v){ g_core->SetLateInputPolling(strcmp(v, "enabled") == 0); });
+    apply("brimir_rewind",                  g_options.rewind,           [](const char* v){ g_core->SetRewindBufferSize(static_cast<size_t>(atoi(v))); });
+    apply("brimir_rewind_button",           g_options.rewind_button,    set_rewind_button);
+    apply("brimir_frameskip",               g_options.frameskip,        set_frameskip);
+    apply("brimir_thread_budget",           g_options.thread_budget,    [](const char* v){ brimir::CoreWrapper::SetThreadBudget(static_cast<size_t>(atoi(v))); });
+    apply("brimir_thread_placement",        g_options.thread_placement, set_thread_placement);
+    apply("brimir_thread_priority",         g_options.thread_priority,  set_thread_placement);
 }
 
 // Libretro API implementation
@@ -206,6 +335,10 @@ RETRO_API void retro_set_environment(retro_environment_t cb) {
 
     // Check for bitmask input support (avoids 14 separate calls per player per frame)
     g_input_bitmask_supported = cb(RETRO_ENVIRONMENT_GET_INPUT_BITMASKS, nullptr);
+
+    if (!cb(RETRO_ENVIRONMENT_GET_CAN_DUPE, &g_can_dupe)) {
+        g_can_dupe = false;
+    }
 }
 
 RETRO_API void retro_set_video_refresh(retro_video_refresh_t cb) {
@@ -241,6 +374,8 @@ RETRO_API void retro_init(void) {
         return;
     }
 
+    g_core->SetInputStateCallback(late_input_state);
+
     // Register disk control interface for multi-disc games
     unsigned dc_version = 0;
     if (environ_cb && environ_cb(RETRO_ENVIRONMENT_GET_DISK_CONTROL_INTERFACE_VERSION, &dc_version) && dc_version >= 1) {
@@ -301,6 +436,19 @@ RETRO_API void retro_get_system_av_info(struct retro_system_av_info* info) {
     info->timing.sample_rate = 44100.0;
 }
 
+// Auto frameskip keeps up with the content frame rate, or with the display if the frontend targets a slower one
+static void update_frameskip_target_rate(void) {
+    if (!g_core) return;
+
+    double fps = g_core->GetConsoleRegion() == brimir::ConsoleRegion::PAL ? 50.0 : 59.94;
+    float refresh = 0.0f;
+    if (environ_cb && environ_cb(RETRO_ENVIRONMENT_GET_TARGET_REFRESH_RATE, &refresh) && refresh > 0.0f &&
+        refresh < fps) {
+        fps = refresh;
+    }
+    g_core->SetTargetFrameRate(fps);
+}
+
 static void update_system_av_info_for_region(void) {
     if (!environ_cb || !g_core) return;
 
@@ -366,59 +514,47 @@ RETRO_API void retro_run(void) {
         }
     }
 
-    // Poll input
-    if (input_poll_cb) {
-        input_poll_cb();
-    }
-    
-    // Read and update controller input for both players
-    if (input_state_cb) {
-        uint16_t buttons_p1 = 0;
-        uint16_t buttons_p2 = 0;
-
-        if (g_input_bitmask_supported) {
-            // Single call returns all buttons as a bitmask - bits match RETRO_DEVICE_ID_JOYPAD_* values
-            buttons_p1 = static_cast<uint16_t>(input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_MASK));
-            buttons_p2 = static_cast<uint16_t>(input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_MASK));
-        } else {
-            // Fallback: query each button individually
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_B))      buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_B);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_Y))      buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_Y);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_SELECT)) buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_SELECT);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_START))  buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_START);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_UP))     buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_UP);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_DOWN))   buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_DOWN);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_LEFT))   buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_LEFT);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_RIGHT))  buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_RIGHT);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_A))      buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_A);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_X))      buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_X);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L))      buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_L);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R))      buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_R);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L2))     buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_L2);
-            if (input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R2))     buttons_p1 |= (1 << RETRO_DEVICE_ID_JOYPAD_R2);
-
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_B))      buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_B);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_Y))      buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_Y);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_SELECT)) buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_SELECT);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_START))  buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_START);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_UP))     buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_UP);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_DOWN))   buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_DOWN);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_LEFT))   buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_LEFT);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_RIGHT))  buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_RIGHT);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_A))      buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_A);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_X))      buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_X);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L))      buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_L);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R))      buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_R);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L2))     buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_L2);
-            if (input_state_cb(1, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R2))     buttons_p2 |= (1 << RETRO_DEVICE_ID_JOYPAD_R2);
+    // Poll input. In late polling mode the frontend is polled from the peripheral
+    // report callback instead, when the game actually reads the pads.
+    const bool late_poll = g_core->IsLateInputPolling();
+    g_input_polled_this_frame = false;
+    if (!late_poll) {
+        if (input_poll_cb) {
+            input_poll_cb();
         }
 
-        g_core->SetControllerState(0, buttons_p1);
-        g_core->SetControllerState(1, buttons_p2);
+        // Read and update controller input for both players
+        if (input_state_cb) {
+            g_port1_buttons = read_joypad_buttons(0);
+            g_core->SetControllerState(0, g_port1_buttons);
+            g_core->SetControllerState(1, read_joypad_buttons(1));
+        }
     }
-    
+
+    // In late polling mode this sees the buttons from the previous poll
+    g_core->SetRewinding((g_port1_buttons & g_rewind_button_mask) != 0);
+
+    // The frontend may discard this frame's video, e.g. in the second instance of its runahead
+    int av_enable = 0;
+    if (environ_cb && environ_cb(RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE, &av_enable) && !(av_enable & 1)) {
+        g_core->RequestFrameSkip();
+    }
+
     // Run one frame of emulation
     g_core->RunFrame();
+
+    // Frontends expect one poll per retro_run; do it now if the game never read
+    // the pads this frame, and keep the stored masks current for the next one.
+    if (late_poll && !g_input_polled_this_frame) {
+        if (input_poll_cb) {
+            input_poll_cb();
+        }
+        if (input_state_cb) {
+            g_port1_buttons = read_joypad_buttons(0);
+            g_core->SetControllerState(0, g_port1_buttons);
+            g_core->SetControllerState(1, read_joypad_buttons(1));
+        }
+    }
     
     // Output video
     if (video_cb) {
@@ -443,7 +579,8 @@ RETRO_API void retro_run(void) {
             s_lastHeight = height;
         }
         
-        video_cb(fb, width, height, pitch);
+        // Skipped frames left the previous image in the framebuffer; let the frontend repeat it if it can
+        video_cb(g_core->IsFrameSkipped() && g_can_dupe ? nullptr : fb, width, height, pitch);
     }
     
     // Output audio
@@ -641,6 +778,7 @@ RETRO_API bool retro_load_game(const struct retro_game_info* game) {
     apply_core_options(true);
 
     update_system_av_info_for_region();
+    update_frameskip_target_rate();
 
     g_core->SetRenderer("software");
 
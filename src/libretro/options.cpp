@@ -27,6 +27,11 @@ static struct retro_core_option_v2_category option_cats[] = {
         "Media Settings",
         "Configure CD-ROM and disc loading"
     },
+    {
+        "input",
+        "Input Settings",
+        "Configure input latency reduction"
+    },
     { nullptr, nullptr, nullptr }
 };
 
@@ -118,6 +123,24 @@ static struct retro_core_option_v2_definition option_defs[] = {
         },
         "enabled"
     },
+    {
+        "brimir_frameskip",
+        "Frameskip",
+        nullptr,
+        "Skip drawing the screen on some frames to keep full speed on slow hardware. Games keep running and sound "
+        "normally. Auto only skips when the host falls behind, judged by the frontend's audio buffer when available.",
+        nullptr,
+        "video",
+        {
+            { "0", "OFF" },
+            { "1", "1 frame" },
+            { "2", "2 frames" },
+            { "3", "3 frames" },
+            { "auto", "Auto" },
+            { nullptr, nullptr }
+        },
+        "0"
+    },
     {
         "brimir_autodetect_region",
         "Auto-Detect Region from Disc",
@@ -262,6 +285,131 @@ static struct retro_core_option_v2_definition option_defs[] = {
         },
         "100"
     },
+    {
+        "brimir_thread_budget",
+        "Thread Limit",
+        nullptr,
+        "Maximum number of threads the core runs at once, shared by every open instance. "
+        "Rendering, sound and CPU threads come first; save state and rewind compression use whatever is left. "
+        "Auto uses one thread per hardware thread. Lower it when running several instances side by side.",
+        nullptr,
+        "system",
+        {
+            { "auto", "Auto" },
+            { "2", "2" },
+            { "3", "3" },
+            { "4", "4" },
+            { "6", "6" },
+            { "8", "8" },
+            { "12", "12" },
+            { "16", "16" },
+            { nullptr, nullptr }
+        },
+        "auto"
+    },
+    {
+        "brimir_thread_placement",
+        "Thread Placement (Linux)",
+        nullptr,
+        "Auto gives the emulation thread the fastest CPU core to itself and puts the video and sound threads on "
+        "other physical cores, preferring performance cores on hybrid CPUs. Reduces frame time spikes on dedicated "
+        "machines. Per-thread CPUs and priorities can be set with the BRIMIR_THREAD_PLACEMENT environment variable.",
+        nullptr,
+        "system",
+        {
+            { "disabled", "OFF" },
+            { "auto", "Auto" },
+            { nullptr, nullptr }
+        },
+        "disabled"
+    },
+    {
+        "brimir_thread_priority",
+        "Thread Priority (Linux)",
+        nullptr,
+        "High raises the priority of the emulation, video and sound threads. Realtime also runs the emulation and "
+        "sound threads under the SCHED_FIFO real-time scheduler. Both need permission to raise priorities, "
+        "e.g. CAP_SYS_NICE or matching limits in /etc/security/limits.conf.",
+        nullptr,
+        "system",
+        {
+            { "normal", "Normal" },
+            { "high", "High" },
+            { "realtime", "Realtime" },
+            { nullptr, nullptr }
+        },
+        "normal"
+    },
+    {
+        "brimir_runahead",
+        "Internal Run-Ahead",
+        nullptr,
+        "Hide the game's internal input lag by running frames ahead inside the core. "
+        "Much cheaper than the frontend's Run-Ahead, which compresses a full save state every frame. "
+        "Each frame costs one extra emulated frame per run-ahead frame. Do not combine with the frontend's Run-Ahead.",
+        nullptr,
+        "input",
+        {
+            { "0", "OFF" },
+            { "1", "1 frame" },
+            { "2", "2 frames" },
+            { "3", "3 frames" },
+            { "4", "4 frames" },
+            { nullptr, nullptr }
+        },
+        "0"
+    },
+    {
+        "brimir_late_input_poll",
+        "Late Input Polling",
+        nullptr,
+        "Read the controllers at the moment the game asks the SMPC for pad data, instead of at the start of the frame. "
+        "Can cut input lag by up to one frame at no performance cost.",
+        nullptr,
+        "input",
+        {
+            { "disabled", "OFF" },
+            { "enabled", "ON" },
+            { nullptr, nullptr }
+        },
+        "disabled"
+    },
+    {
+        "brimir_rewind",
+        "Core Rewind",
+        nullptr,
+        "Record every frame into a rewind buffer of this size and step back while the Core Rewind Button is held. "
+        "Stores compressed differences between frames, so it keeps far more history than the frontend's Rewind "
+        "in the same memory. Do not combine with the frontend's Rewind.",
+        nullptr,
+        "input",
+        {
+            { "0", "OFF" },
+            { "128", "128 MB" },
+            { "256", "256 MB" },
+            { "512", "512 MB" },
+            { "1024", "1024 MB" },
+            { nullptr, nullptr }
+        },
+        "0"
+    },
+    {
+        "brimir_rewind_button",
+        "Core Rewind Button",
+        nullptr,
+        "Player 1 button to hold for Core Rewind. Unbound by default so that the button stays free for the "
+        "frontend's own hotkeys.",
+        nullptr,
+        "input",
+        {
+            { "disabled", "Unbound" },
+            { "l3", "L3" },
+            { "r3", "R3" },
+            { "select", "Select" },
+            { nullptr, nullptr }
+        },
+        "disabled"
+    },
     {
         "brimir_profiling",
         "Performance Profiling",
@@ -45,6 +45,14 @@ TEST_CASE("Core options default values match OptionCache defaults", "[options][l
         { "brimir_cd_speed",             "2"        },
         { "brimir_sh2_overclock",        "100"      },
         { "brimir_profiling",            "disabled" },
+        { "brimir_runahead",             "0"        },
+        { "brimir_late_input_poll",      "disabled" },
+        { "brimir_rewind",               "0"        },
+        { "brimir_rewind_button",        "disabled" },
+        { "brimir_frameskip",            "0"        },
+        { "brimir_thread_budget",        "auto"     },
+        { "brimir_thread_placement",     "disabled" },
+        { "brimir_thread_priority",      "normal"   },
     };
 
     for (const auto& e : expected) {
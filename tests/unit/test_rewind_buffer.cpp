@@ -0,0 +1,126 @@
+// Rewind buffer unit tests
+#include "catch_amalgamated.hpp"
+#include <brimir/rewind_buffer.hpp>
+#include <ymir/util/thread_pool.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace brimir;
+
+namespace {
+
+// Produces a sequence of snapshots that change a little from one to the next, like emulator states do
+class SnapshotGenerator {
+public:
+    explicit SnapshotGenerator(size_t size)
+        : m_image(size) {
+        for (auto& byte : m_image) {
+            byte = static_cast<uint8_t>(m_rng());
+        }
+    }
+
+    std::vector<uint8_t> Next(size_t changes, size_t newSize = 0) {
+        if (newSize != 0) {
+            m_image.resize(newSize, 0x5A);
+        }
+        for (size_t i = 0; i < changes; ++i) {
+            m_image[m_rng() % m_image.size()] = static_cast<uint8_t>(m_rng());
+        }
+        return m_image;
+    }
+
+private:
+    std::mt19937 m_rng{1234};
+    std::vector<uint8_t> m_image;
+};
+
+bool HeadEquals(const RewindBuffer& buffer, const std::vector<uint8_t>& expected) {
+    const auto head = buffer.GetHead();
+    return std::equal(head.begin(), head.end(), expected.begin(), expected.end());
+}
+
+} // namespace
+
+TEST_CASE("Rewind buffer steps back through every snapshot", "[rewind][unit]") {
+    util::ThreadPool pool{3};
+    RewindBuffer buffer{pool, 64 * 1024 * 1024, 4};
+    SnapshotGenerator gen{300 * 1024};
+
+    std::vector<std::vector<uint8_t>> history;
+    for (size_t i = 0; i < 23; ++i) {
+        // Unchanged frames, scattered changes and size changes across keyframe boundaries
+        const size_t newSize = i == 9 ? 310 * 1024 : i == 15 ? 200 * 1024 + 7 : 0;
+        history.push_back(gen.Next(i % 3 == 0 ? 0 : 50, newSize));
+        auto image = history.back();
+        REQUIRE(buffer.Push(image));
+        REQUIRE(HeadEquals(buffer, history.back()));
+    }
+    REQUIRE(buffer.GetFrameCount() == history.size());
+
+    for (size_t i = history.size() - 1; i > 0; --i) {
+        REQUIRE(buffer.Pop());
+        REQUIRE(HeadEquals(buffer, history[i - 1]));
+    }
+    REQUIRE_FALSE(buffer.Pop());
+    REQUIRE(HeadEquals(buffer, history[0]));
+
+    // Recording resumes from wherever the head is
+    auto image = gen.Next(10);
+    REQUIRE(buffer.Push(image));
+    REQUIRE(buffer.Pop());
+    REQUIRE(HeadEquals(buffer, history[0]));
+}
+
+TEST_CASE("Rewind buffer stores unchanged snapshots almost for free", "[rewind][unit]") {
+    util::ThreadPool pool{1};
+    RewindBuffer buffer{pool, 16 * 1024 * 1024};
+    SnapshotGenerator gen{1024 * 1024};
+
+    auto image = gen.Next(0);
+    REQUIRE(buffer.Push(image));
+    const size_t keyframeSize = buffer.GetUsedBytes();
+    for (size_t i = 0; i < 100; ++i) {
+        image = gen.Next(0);
+        REQUIRE(buffer.Push(image));
+    }
+    REQUIRE(buffer.GetFrameCount() == 101);
+    REQUIRE(buffer.GetUsedBytes() - keyframeSize < 100 * 128);
+}
+
+TEST_CASE("Rewind buffer drops the oldest keyframe and its deltas when full", "[rewind][unit]") {
+    util::ThreadPool pool{2};
+    constexpr size_t kCapacity = 2 * 1024 * 1024;
+    RewindBuffer buffer{pool, kCapacity, 8};
+    SnapshotGenerator gen{256 * 1024};
+
+    std::vector<std::vector<uint8_t>> history;
+    for (size_t i = 0; i < 200; ++i) {
+        history.push_back(gen.Next(2000));
+        auto image = history.back();
+        REQUIRE(buffer.Push(image));
+        REQUIRE(buffer.GetUsedBytes() <= kCapacity);
+    }
+
+    const size_t frames = buffer.GetFrameCount();
+    REQUIRE(frames > 8);
+    REQUIRE(frames < history.size());
+
+    // Everything still held decodes back to the exact snapshots
+    for (size_t i = 1; i < frames; ++i) {
+        REQUIRE(buffer.Pop());
+        REQUIRE(HeadEquals(buffer, history[history.size() - 1 - i]));
+    }
+    REQUIRE_FALSE(buffer.Pop());
+}
+
+TEST_CASE("Rewind buffer rejects snapshots larger than the ring", "[rewind][unit]") {
+    util::ThreadPool pool{1};
+    RewindBuffer buffer{pool, 64 * 1024};
+    SnapshotGenerator gen{256 * 1024};
+
+    auto image = gen.Next(0);
+    REQUIRE_FALSE(buffer.Push(image));
+    REQUIRE(buffer.GetFrameCount() == 0);
+    REQUIRE(buffer.GetHead().empty());
+}
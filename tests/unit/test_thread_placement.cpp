@@ -0,0 +1,101 @@
+// Thread placement unit tests
+#include "catch_amalgamated.hpp"
+#include <ymir/util/thread_placement.hpp>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+using namespace util;
+
+namespace {
+
+const ThreadPlacement& Of(const ThreadPlacements& placements, ThreadRole role) {
+    return placements[static_cast<size_t>(role)];
+}
+
+} // namespace
+
+TEST_CASE("Thread placement specifications are parsed per role", "[threadplacement][unit]") {
+    const auto parsed = ParseThreadPlacements("vdp2:cpus=2-3,6:nice=-5;scsp:fifo=20;;main:cpus=0");
+    REQUIRE(parsed.has_value());
+
+    REQUIRE(Of(*parsed, ThreadRole::VDP2Render).affinity == 0b1001100u);
+    REQUIRE(Of(*parsed, ThreadRole::VDP2Render).nice == -5);
+    REQUIRE_FALSE(Of(*parsed, ThreadRole::VDP2Render).realtimePriority.has_value());
+    REQUIRE(Of(*parsed, ThreadRole::SCSP).realtimePriority == 20);
+    REQUIRE_FALSE(Of(*parsed, ThreadRole::SCSP).affinity.has_value());
+    REQUIRE(Of(*parsed, ThreadRole::Emulation).affinity == 1u);
+    REQUIRE_FALSE(Of(*parsed, ThreadRole::VDP1Render).affinity.has_value());
+
+    REQUIRE(ParseThreadPlacements("").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("gpu:cpus=1").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("vdp1:cpus=3-1").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("vdp1:cpus=64").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("vdp1:nice=-21").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("scsp:fifo=0").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("scsp:speed=1").has_value());
+    REQUIRE_FALSE(ParseThreadPlacements("scsp:fifo").has_value());
+}
+
+TEST_CASE("Automatic placement gives threads their own physical cores", "[threadplacement][unit]") {
+    // Two SMT performance cores followed by two efficiency cores
+    const std::vector<CPUCore> cores{{0b0011, 200}, {0b1100, 200}, {0b010000, 100}, {0b100000, 100}};
+    const auto placements = ComputeAutomaticAffinities(cores);
+
+    REQUIRE(Of(placements, ThreadRole::Emulation).affinity == 0b0011u);
+    REQUIRE(Of(placements, ThreadRole::VDP2Render).affinity == 0b1100u);
+    REQUIRE(Of(placements, ThreadRole::VDP1Render).affinity == 0b010000u);
+    REQUIRE(Of(placements, ThreadRole::SCSP).affinity == 0b100000u);
+    REQUIRE(Of(placements, ThreadRole::SH2Speculation).affinity == 0b1100u);
+    REQUIRE(Of(placements, ThreadRole::PoolWorker).affinity == 0b111100u);
+    for (const auto& placement : placements) {
+        REQUIRE_FALSE(placement.nice.has_value());
+        REQUIRE_FALSE(placement.realtimePriority.has_value());
+    }
+
+    // Nothing to spread threads over on a single core
+    const std::vector<CPUCore> single{{0b1, 0}};
+    for (const auto& placement : ComputeAutomaticAffinities(single)) {
+        REQUIRE_FALSE(placement.affinity.has_value());
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("Thread placement is applied to registered threads and undone on exit", "[threadplacement][unit]") {
+    // Lowering a thread's priority never needs extra permissions
+    ThreadPlacements placements{};
+    placements[static_cast<size_t>(ThreadRole::SH2Speculation)].nice = 7;
+    ConfigureThreadPlacement(placements, false);
+
+    int niceBefore = 0;
+    int niceInside = 0;
+    int niceAfter = -1;
+    int niceReconfigured = 0;
+    std::thread thread{[&] {
+        const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+        niceBefore = getpriority(PRIO_PROCESS, tid);
+        {
+            ScopedThreadPlacement placement{ThreadRole::SH2Speculation};
+            niceInside = getpriority(PRIO_PROCESS, tid);
+
+            placements[static_cast<size_t>(ThreadRole::SH2Speculation)].nice = 9;
+            ConfigureThreadPlacement(placements, false);
+            niceReconfigured = getpriority(PRIO_PROCESS, tid);
+        }
+        niceAfter = getpriority(PRIO_PROCESS, tid);
+    }};
+    thread.join();
+    ConfigureThreadPlacement({}, false);
+
+    REQUIRE(niceBefore <= 7);
+    REQUIRE(niceInside == 7);
+    REQUIRE(niceReconfigured == 9);
+    REQUIRE(niceAfter == niceBefore);
+    REQUIRE(IsThreadPlacementApplied());
+}
+#endif
@@ -0,0 +1,72 @@
+// Shared thread pool unit tests
+#include "catch_amalgamated.hpp"
+#include <ymir/util/thread_pool.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using util::ThreadPool;
+
+TEST_CASE("Thread pool runs every task exactly once", "[threadpool][unit]") {
+    ThreadPool pool{4};
+
+    for (const size_t count : {0, 1, 2, 3, 7, 100, 1001}) {
+        std::vector<std::atomic<int>> runs(count);
+        pool.ParallelFor(count, [&](size_t i) { runs[i].fetch_add(1); });
+        for (size_t i = 0; i < count; ++i) {
+            INFO("count=" << count << " task=" << i);
+            REQUIRE(runs[i].load() == 1);
+        }
+    }
+}
+
+TEST_CASE("Thread pool runs nested and concurrent batches inline", "[threadpool][unit]") {
+    ThreadPool pool{4};
+
+    // Batches submitted from within a task
+    std::atomic<int> inner = 0;
+    pool.ParallelFor(8, [&](size_t) { pool.ParallelFor(5, [&](size_t) { inner.fetch_add(1); }); });
+    REQUIRE(inner.load() == 40);
+
+    // Batches submitted from several threads at once
+    std::atomic<int> total = 0;
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 4; ++t) {
+        submitters.emplace_back([&] {
+            for (int batch = 0; batch < 50; ++batch) {
+                pool.ParallelFor(16, [&](size_t) { total.fetch_add(1); });
+            }
+        });
+    }
+    for (auto& submitter : submitters) {
+        submitter.join();
+    }
+    REQUIRE(total.load() == 4 * 50 * 16);
+}
+
+TEST_CASE("Thread pool dedicated threads count against the budget", "[threadpool][unit]") {
+    ThreadPool pool{4};
+    REQUIRE(pool.GetAvailableHelperCount() == 3);
+
+    std::atomic<bool> release = false;
+    std::thread first = pool.StartDedicated([&] { release.wait(false); });
+    std::thread second = pool.StartDedicated([&] { release.wait(false); });
+    REQUIRE(pool.GetDedicatedThreadCount() == 2);
+    REQUIRE(pool.GetAvailableHelperCount() == 1);
+
+    // Batches still complete with the caller alone
+    pool.SetThreadBudget(2);
+    REQUIRE(pool.GetAvailableHelperCount() == 0);
+    std::atomic<int> runs = 0;
+    pool.ParallelFor(10, [&](size_t) { runs.fetch_add(1); });
+    REQUIRE(runs.load() == 10);
+
+    release = true;
+    release.notify_all();
+    first.join();
+    second.join();
+    REQUIRE(pool.GetDedicatedThreadCount() == 0);
+
+    pool.SetThreadBudget(0);
+    REQUIRE(pool.GetThreadBudget() == ThreadPool::DefaultThreadBudget());
+}
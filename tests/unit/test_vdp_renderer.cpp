@@ -0,0 +1,366 @@
+// VDP software renderer fast path tests
+// Each fast path must produce the same output as the generic code it replaces. These tests render randomized scenes
+// with the fast path enabled and disabled and compare the results.
+#include "catch_amalgamated.hpp"
+#include <ymir/hw/vdp/renderer/vdp_renderer_sw.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace ymir;
+using namespace ymir::vdp;
+
+namespace {
+
+using FastPaths = SoftwareVDPRenderer::FastPaths;
+
+// Fills a byte array with random data, four bytes per draw
+template <size_t N>
+void FillRandom(std::array<uint8_t, N> &array, std::mt19937 &rng) {
+    static_assert(N % sizeof(uint32_t) == 0);
+    for (size_t i = 0; i < N; i += sizeof(uint32_t)) {
+        const uint32_t value = rng();
+        std::memcpy(&array[i], &value, sizeof(value));
+    }
+}
+
+// A software renderer with its own VDP state
+struct Renderer {
+    std::unique_ptr<VDPState> state = std::make_unique<VDPState>();
+    config::VDP2DebugRender debugRender;
+    config::VDP2AccessPatternsConfig accessPatterns;
+    std::unique_ptr<SoftwareVDPRenderer> renderer =
+        std::make_unique<SoftwareVDPRenderer>(*state, debugRender, accessPatterns);
+};
+
+// Parameters of a randomized VDP1 drawing command
+struct VDP1Scene {
+    uint32_t seed;
+    VDP1Command::CommandType command;
+    VDP1Command::DrawMode mode;
+    bool pixel8Bits;
+    bool transparentMeshes;
+    bool insideSystemClip = false; // Place the sprite entirely inside the system clipping area
+};
+
+// The draw framebuffer after executing a command, and whether the command changed it
+struct VDP1Result {
+    SpriteFB fb;
+    bool drawn;
+
+    bool operator==(const VDP1Result &) const = default;
+};
+
+// Fills VDP1 VRAM and the framebuffers from the scene seed, executes one textured drawing command and returns the
+// draw framebuffer. The character data is biased towards end codes and transparent texels.
+VDP1Result DrawVDP1Scene(const VDP1Scene &scene, const FastPaths &fastPaths) {
+    Renderer r;
+    r.renderer->fastPaths = fastPaths;
+    config::Enhancements enhancements{};
+    enhancements.transparentMeshes = scene.transparentMeshes;
+    r.renderer->ConfigureEnhancements(enhancements);
+
+    std::mt19937 rng{scene.seed};
+    VDPState &state = *r.state;
+    FillRandom(state.mem1.VRAM, rng);
+    for (auto &fb : state.spriteFB) {
+        FillRandom(fb, rng);
+    }
+    state.state2.layerEnabled[0] = true;
+    state.regs1.fbSizeH = 512;
+    state.regs1.pixel8Bits = scene.pixel8Bits;
+    state.state1.sysClipH = 319 + rng() % 100;
+    state.state1.sysClipV = 223 + rng() % 30;
+    state.state1.userClipX0 = rng() % 100;
+    state.state1.userClipY0 = rng() % 100;
+    state.state1.userClipX1 = state.state1.userClipX0 + rng() % 300;
+    state.state1.userClipY1 = state.state1.userClipY0 + rng() % 200;
+    state.state1.localCoordX = 0;
+    state.state1.localCoordY = 0;
+
+    auto write16 = [&](uint32_t address, uint16_t value) {
+        state.mem1.VRAM[address] = value >> 8u;
+        state.mem1.VRAM[address + 1] = value;
+    };
+
+    const uint16_t charAddr = rng();
+    for (uint32_t i = 0; i < 2048; ++i) {
+        static constexpr uint8_t kBiased[] = {0xFF, 0x00, 0xF0, 0x0F, 0x7F};
+        const uint32_t address = (charAddr * 8u + i) & (kVDP1VRAMSize - 1);
+        state.mem1.VRAM[address] = rng() % 2 ? kBiased[rng() % std::size(kBiased)] : rng();
+    }
+
+    const uint32_t w = (rng() % 8) * 8 + (rng() % 4 == 0 ? 0 : 8);
+    const uint32_t h = rng() % 40 + (rng() % 8 == 0 ? 0 : 1);
+    sint32 x = static_cast<sint32>(rng() % 360) - 20;
+    sint32 y = static_cast<sint32>(rng() % 260) - 20;
+    if (scene.insideSystemClip) {
+        x = rng() % (state.state1.sysClipH + 2 - std::max(w, 1u));
+        y = rng() % (state.state1.sysClipV + 2 - std::max(h, 1u));
+    }
+
+    VDP1Command::Control control{.u16 = 0};
+    control.command = scene.command;
+    control.flipH = rng() % 2;
+    control.flipV = rng() % 2;
+
+    const uint32_t cmdAddress = 0x1000;
+    write16(cmdAddress + 0x00, control.u16);
+    write16(cmdAddress + 0x04, scene.mode.u16);
+    write16(cmdAddress + 0x06, rng());
+    write16(cmdAddress + 0x08, charAddr);
+    write16(cmdAddress + 0x0A, ((w / 8) << 8u) | h);
+    if (scene.command == VDP1Command::CommandType::DrawNormalSprite) {
+        write16(cmdAddress + 0x0C, x);
+        write16(cmdAddress + 0x0E, y);
+    } else {
+        // Any quadrilateral around the position, including twisted and degenerate ones
+        for (uint32_t i = 0; i < 4; ++i) {
+            write16(cmdAddress + 0x0C + i * 4, x + static_cast<sint32>(rng() % 160) - 40);
+            write16(cmdAddress + 0x0E + i * 4, y + static_cast<sint32>(rng() % 120) - 30);
+        }
+    }
+    write16(cmdAddress + 0x1C, 0x2000);
+
+    const SpriteFB initial = state.spriteFB[state.displayFB ^ 1];
+    r.renderer->VDP1BeginFrame();
+    r.renderer->VDP1ExecuteCommand(cmdAddress, control);
+    const SpriteFB &fb = state.spriteFB[state.displayFB ^ 1];
+    return {fb, fb != initial};
+}
+
+// Fills VDP2 VRAM, CRAM, registers and the sprite framebuffer from the seed, lets `setup` adjust the registers with
+// `setup(write, state, rng)` and renders a frame. Runs of VRAM of every length are cleared so that scenes contain fully
+// and partially transparent characters.
+template <typename Setup>
+std::vector<uint32_t> RenderVDP2Scene(uint32_t seed, const FastPaths &fastPaths, Setup &&setup) {
+    Renderer r;
+    r.renderer->fastPaths = fastPaths;
+
+    std::mt19937 rng{seed};
+    VDPState &state = *r.state;
+    FillRandom(state.mem2.VRAM, rng);
+    for (uint32_t i = 0; i < 512; ++i) {
+        const uint32_t address = rng() % kVDP2VRAMSize;
+        std::fill_n(&state.mem2.VRAM[address], std::min<uint32_t>(1u << (rng() % 13), kVDP2VRAMSize - address), 0);
+    }
+    for (uint32_t address = 0; address < kVDP2CRAMSize; address += sizeof(uint16_t)) {
+        const uint16_t value = rng();
+        state.mem2.WriteCRAM<uint16>(address, value);
+        r.renderer->VDP2WriteCRAM(address, value);
+    }
+    FillRandom(state.spriteFB[state.displayFB], rng);
+
+    auto write = [&](uint32_t address, uint16_t value) {
+        state.regs2.Write(address, value);
+        r.renderer->VDP2WriteReg(address, value);
+    };
+    // Every register but TVMD and the status registers, then display on in any non-interlaced, non-exclusive mode
+    for (uint32_t address = 0x002; address < 0x120; address += sizeof(uint16_t)) {
+        if (address != 0x004 && address != 0x006) {
+            write(address, rng());
+        }
+    }
+    write(0x000, 0x8000 | (rng() % 4));
+    setup(write, state, rng);
+    state.regs2.LatchTVMD();
+    static constexpr uint32_t kWidths[] = {320, 352, 640, 704};
+    r.renderer->VDP2SetResolution(kWidths[state.regs2.TVMD.HRESOn & 3], 224, false);
+
+    std::vector<uint32_t> frame{};
+    r.renderer->SwCallbacks.FrameComplete.Rebind(&frame, [](uint32 *fb, uint32 width, uint32 height, void *ctx) {
+        static_cast<std::vector<uint32_t> *>(ctx)->assign(fb, fb + width * height);
+    });
+    r.renderer->VDP2BeginFrame();
+    for (uint32_t y = 0; y < 224; ++y) {
+        r.renderer->VDP2RenderLine(y);
+    }
+    r.renderer->VDP2EndFrame();
+    return frame;
+}
+
+// Finds the first pixel where two frames differ, or returns the frame size if they are identical
+size_t FindMismatch(const std::vector<uint32_t> &lhs, const std::vector<uint32_t> &rhs) {
+    REQUIRE(lhs.size() == rhs.size());
+    return std::mismatch(lhs.begin(), lhs.end(), rhs.begin()).first - lhs.begin();
+}
+
+// Determines if a frame shows more than a single color
+bool HasDetail(const std::vector<uint32_t> &frame) {
+    return std::adjacent_find(frame.begin(), frame.end(), std::not_equal_to{}) != frame.end();
+}
+
+} // namespace
+
+TEST_CASE("VDP1 textured line kernels match the generic line", "[vdp][vdp1][unit]") {
+    FastPaths kernels{};
+    FastPaths generic{};
+    generic.vdp1LineKernels = false;
+
+    // Every kernel of the table: color modes including the invalid ones, every pixel operation, gouraud and mesh
+    std::mt19937 rng{41};
+    uint32_t drawn = 0;
+    for (uint32_t colorMode = 0; colorMode < 8; ++colorMode) {
+        for (uint32_t pixelOp = 0; pixelOp < 5; ++pixelOp) {
+            for (uint32_t gouraudMesh = 0; gouraudMesh < 4; ++gouraudMesh) {
+                for (uint32_t iter = 0; iter < 4; ++iter) {
+                    VDP1Command::DrawMode mode{.u16 = static_cast<uint16_t>(rng())};
+                    mode.colorMode = colorMode;
+                    mode.colorCalcBits = pixelOp & 3;
+                    mode.msbOn = pixelOp == 4;
+                    mode.gouraudEnable = gouraudMesh & 1;
+                    mode.meshEnable = (gouraudMesh >> 1) & 1;
+
+                    const VDP1Scene scene{
+                        .seed = static_cast<uint32_t>(rng()),
+                        .command = VDP1Command::CommandType::DrawDistortedSprite,
+                        .mode = mode,
+                        .pixel8Bits = iter == 3,
+                        .transparentMeshes = iter == 2,
+                    };
+                    INFO("mode=" << mode.u16 << " seed=" << scene.seed << " pixel8Bits=" << scene.pixel8Bits);
+                    const VDP1Result result = DrawVDP1Scene(scene, kernels);
+                    REQUIRE(result == DrawVDP1Scene(scene, generic));
+                    drawn += result.drawn;
+                }
+            }
+        }
+    }
+    // Most scenes must actually draw something for the comparison to mean anything
+    REQUIRE(drawn > 8 * 5 * 4 * 4 / 2);
+}
+
+TEST_CASE("VDP1 normal sprite blits match textured quads", "[vdp][vdp1][unit]") {
+    FastPaths blit{};
+    FastPaths quad{};
+    quad.vdp1SpriteBlit = false;
+
+    // Valid color modes including the lookup table mode, every pixel operation, user clipping inside and outside,
+    // end codes enabled and disabled, on 16-bit and 8-bit framebuffers
+    std::mt19937 rng{42};
+    uint32_t drawn = 0;
+    for (uint32_t colorMode = 0; colorMode < 6; ++colorMode) {
+        for (uint32_t pixelOp = 0; pixelOp < 5; ++pixelOp) {
+            for (uint32_t clipping = 0; clipping < 8; ++clipping) {
+                for (uint32_t iter = 0; iter < 3; ++iter) {
+                    VDP1Command::DrawMode mode{.u16 = static_cast<uint16_t>(rng())};
+                    mode.colorMode = colorMode;
+                    mode.colorCalcBits = pixelOp & 3;
+                    mode.msbOn = pixelOp == 4;
+                    mode.gouraudEnable = 0;
+                    mode.meshEnable = 0;
+                    mode.userClippingEnable = clipping & 1;
+                    mode.clippingMode = (clipping >> 1) & 1;
+                    mode.endCodeDisable = (clipping >> 2) & 1;
+
+                    const VDP1Scene scene{
+                        .seed = static_cast<uint32_t>(rng()),
+                        .command = VDP1Command::CommandType::DrawNormalSprite,
+                        .mode = mode,
+                        .pixel8Bits = iter == 1,
+                        .transparentMeshes = iter == 2,
+                        .insideSystemClip = iter != 2,
+                    };
+                    INFO("mode=" << mode.u16 << " seed=" << scene.seed << " pixel8Bits=" << scene.pixel8Bits);
+                    const VDP1Result result = DrawVDP1Scene(scene, blit);
+                    REQUIRE(result == DrawVDP1Scene(scene, quad));
+                    drawn += result.drawn;
+                }
+            }
+        }
+    }
+    REQUIRE(drawn > 6 * 5 * 8 * 3 / 2);
+}
+
+TEST_CASE("VDP2 scroll BG spans match the per-pixel loop", "[vdp][vdp2][unit]") {
+    FastPaths spans{};
+    FastPaths perPixel{};
+    perPixel.vdp2ScrollSpans = false;
+
+    // Character pattern NBGs without mosaic or vertical cell scrolling, with NBG0 and NBG1 unscaled or scaled by whole
+    // dots, so that every line without line zoom takes the span path
+    auto setup = [](auto &write, VDPState &, std::mt19937 &rng) {
+        write(0x020, 0x0003 | (rng() & 0x1F0C)); // BGON: NBG0 and NBG1, maybe NBG2 and NBG3
+        write(0x022, 0x0000);                     // MZCTL: no mosaic
+        write(0x028, rng() & ~0x0202);            // CHCTLA: NBG0 and NBG1 character patterns
+        write(0x09A, rng() & ~0x0101);            // SCRCTL: no vertical cell scroll
+        write(0x0F8, (rng() & 0x0707) | 0x0101);  // PRINA: NBG0 and NBG1 visible
+        write(0x0FA, (rng() & 0x0707) | 0x0101);  // PRINB: NBG2 and NBG3 visible
+        for (uint32_t bg = 0; bg < 2; ++bg) {
+            write(0x078 + bg * 0x10, 1 + rng() % 2); // ZMXINn
+            write(0x07A + bg * 0x10, 0x0000);        // ZMXDNn
+        }
+    };
+
+    std::mt19937 rng{43};
+    uint32_t detailed = 0;
+    for (uint32_t iter = 0; iter < 200; ++iter) {
+        const uint32_t seed = rng();
+        INFO("seed=" << seed);
+        const std::vector<uint32_t> frame = RenderVDP2Scene(seed, spans, setup);
+        REQUIRE(FindMismatch(frame, RenderVDP2Scene(seed, perPixel, setup)) == frame.size());
+        detailed += HasDetail(frame);
+    }
+    // Random access patterns and color formats leave many scenes blank, but a good share must show something
+    REQUIRE(detailed > 200 / 3);
+}
+
+TEST_CASE("VDP2 rotation coordinate kernels match the scalar loops", "[vdp][vdp2][unit]") {
+    FastPaths simd{};
+    FastPaths scalar{};
+    scalar.vdp2RotationSIMD = false;
+
+    // RBG0 alone or with RBG1, with random rotation parameter tables and coefficient tables, on rotated and unrotated
+    // sprite framebuffers
+    auto setup = [](auto &write, VDPState &state, std::mt19937 &rng) {
+        write(0x020, (rng() & 0x1F0F) | (rng() % 2 ? 0x0030 : 0x0010)); // BGON: RBG0, maybe RBG1
+        write(0x0FC, (rng() & 0x0007) | 0x0001);                        // PRIR: RBG0 visible
+        state.regs1.fbRotEnable = rng() % 2;
+    };
+
+    std::mt19937 rng{44};
+    uint32_t detailed = 0;
+    for (uint32_t iter = 0; iter < 200; ++iter) {
+        const uint32_t seed = rng();
+        INFO("seed=" << seed);
+        const std::vector<uint32_t> frame = RenderVDP2Scene(seed, simd, setup);
+        REQUIRE(FindMismatch(frame, RenderVDP2Scene(seed, scalar, setup)) == frame.size());
+        detailed += HasDetail(frame);
+    }
+    REQUIRE(detailed > 200 / 3);
+}
+
+TEST_CASE("VDP2 window masks match per-pixel windows", "[vdp][vdp2][unit]") {
+    FastPaths masks{};
+    FastPaths perPixel{};
+    perPixel.vdp2WindowMasks = false;
+
+    // Random window control on every layer: AND and OR logic, normal and inverted areas, line windows and sprite
+    // windows. Window coordinates are inside the screen half of the time and anywhere otherwise.
+    auto setup = [](auto &write, VDPState &, std::mt19937 &rng) {
+        write(0x020, rng() & 0x1F3F); // BGON: any layers
+        for (uint32_t address = 0x0C0; address < 0x0D0; address += sizeof(uint16_t)) {
+            if (rng() % 2) {
+                write(address, address & 2 ? rng() % 0x100 : rng() % 0x2D0); // WPSYn/WPEYn or WPSXn/WPEXn
+            }
+        }
+        write(0x0F8, (rng() & 0x0707) | 0x0101); // PRINA
+        write(0x0FA, (rng() & 0x0707) | 0x0101); // PRINB
+        write(0x0FC, (rng() & 0x0007) | 0x0001); // PRIR
+    };
+
+    std::mt19937 rng{45};
+    uint32_t detailed = 0;
+    for (uint32_t iter = 0; iter < 200; ++iter) {
+        const uint32_t seed = rng();
+        INFO("seed=" << seed);
+        const std::vector<uint32_t> frame = RenderVDP2Scene(seed, masks, setup);
+        REQUIRE(FindMismatch(frame, RenderVDP2Scene(seed, perPixel, setup)) == frame.size());
+        detailed += HasDetail(frame);
+    }
+    REQUIRE(detailed > 200 / 3);
+}